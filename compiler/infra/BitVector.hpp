@@ -29,6 +29,10 @@
 #include "env/defines.h"
 #include "infra/Assert.hpp"
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 class TR_BitVector;
 class TR_BitVectorCursor;
 namespace TR { class Compilation; }
@@ -124,6 +128,10 @@ class TR_SingleBitContainer
    void operator-=(TR_SingleBitContainer &other) { if (other._value) { _value = false; } }
    void operator=(TR_SingleBitContainer &other) { _value = other._value; }
 
+   bool orChanged(TR_SingleBitContainer &other) { bool changed = !_value && other._value; _value = _value || other._value; return changed; }
+   bool andChanged(TR_SingleBitContainer &other) { bool changed = _value && !other._value; _value = _value && other._value; return changed; }
+   bool isSubsetOf(TR_SingleBitContainer &other) { return !_value || other._value; }
+
    void setAll(int64_t n) { TR_ASSERT(n < 2, "SingleBitContainers only contain one bit\n"); if (n > 0) { _value = true; } }
    void setAll(int64_t m, int64_t n) { if (m == 0 && n == 1) { _value = true; } }
 
@@ -612,6 +620,110 @@ class TR_BitVector
 
    bool operator!= (TR_BitVector& v2){ return !operator==(v2); }
 
+   // The following fused operations do the work of an assignment, an update and
+   // a comparison in a single pass over the chunks. The chunk loops accumulate
+   // their result instead of exiting early so that the compiler can vectorize them.
+
+   // Perform a bitwise OR between this vector and a second vector and
+   // return true if any bit was added to this vector
+   //
+   bool orChanged(TR_BitVector& v2)
+      {
+      if (v2._lastChunkWithNonZero < 0)
+         return false; // other is empty
+
+      int32_t v2Used = v2._numChunks;
+      if (_numChunks < v2Used)
+         setChunkSize(v2Used);
+
+      chunk_t added = 0;
+      for (int32_t i = v2._firstChunkWithNonZero; i <= v2._lastChunkWithNonZero; i++)
+         {
+         chunk_t oldChunk = _chunks[i];
+         chunk_t newChunk = oldChunk | v2._chunks[i];
+         added |= newChunk ^ oldChunk;
+         _chunks[i] = newChunk;
+         }
+      if (_firstChunkWithNonZero > v2._firstChunkWithNonZero)
+         _firstChunkWithNonZero = v2._firstChunkWithNonZero;
+      if (_lastChunkWithNonZero < v2._lastChunkWithNonZero)
+         _lastChunkWithNonZero = v2._lastChunkWithNonZero;
+#if BV_SANITY_CHECK
+      sanityCheck("orChanged");
+#endif
+      return added != 0;
+      }
+
+   // Perform a bitwise AND between this vector and a second vector and
+   // return true if any bit was removed from this vector
+   //
+   bool andChanged(TR_BitVector& v2)
+      {
+      if (_lastChunkWithNonZero < 0)
+         return false; // Already empty
+      int32_t low = v2._firstChunkWithNonZero;
+      int32_t high = v2._lastChunkWithNonZero;
+      if (high < _firstChunkWithNonZero || low > _lastChunkWithNonZero)
+         {
+         // No intersection, and this vector was not empty
+         this->empty();
+         return true;
+         }
+
+      chunk_t removed = 0;
+      int32_t i;
+      if (low < _firstChunkWithNonZero)
+         low = _firstChunkWithNonZero;
+      else
+         {
+         for (i = _firstChunkWithNonZero; i < low; i++)
+            {
+            removed |= _chunks[i];
+            _chunks[i] = 0;
+            }
+         }
+      if (high > _lastChunkWithNonZero)
+         high = _lastChunkWithNonZero;
+      else
+         {
+         for (i = _lastChunkWithNonZero; i > high; i--)
+            {
+            removed |= _chunks[i];
+            _chunks[i] = 0;
+            }
+         }
+
+      for (i = low; i <= high; i++)
+         {
+         chunk_t oldChunk = _chunks[i];
+         chunk_t newChunk = oldChunk & v2._chunks[i];
+         removed |= newChunk ^ oldChunk;
+         _chunks[i] = newChunk;
+         }
+
+      resetLowAndHighChunks(low, high);
+#if BV_SANITY_CHECK
+      sanityCheck("andChanged");
+#endif
+      return removed != 0;
+      }
+
+   // Determine if every bit set in this vector is also set in a second vector,
+   // i.e. if this vector AND-NOT the second one would be empty
+   //
+   bool isSubsetOf(TR_BitVector& v2)
+      {
+      if (_lastChunkWithNonZero < 0)
+         return true; // empty
+      if (_firstChunkWithNonZero < v2._firstChunkWithNonZero || _lastChunkWithNonZero > v2._lastChunkWithNonZero)
+         return false; // a non-zero chunk of this vector is outside the other's range
+
+      chunk_t extra = 0;
+      for (int32_t i = _firstChunkWithNonZero; i <= _lastChunkWithNonZero; i++)
+         extra |= _chunks[i] & ~v2._chunks[i];
+      return extra == 0;
+      }
+
 
    // Set the first n elements of the set
    //
@@ -958,6 +1070,51 @@ class TR_BitVector
    //
    static int64_t getBitIndex(int32_t chunkIndex) {return ((int64_t)chunkIndex) << SHIFT;}
 
+   // Given a non-zero chunk, calculate the index within the chunk of its lowest numbered set bit
+   //
+   static inline int32_t getFirstBitIndexInChunk(chunk_t chunk)
+      {
+#if defined(BITVECTOR_BIT_NUMBERING_MSB)
+#if defined(__GNUC__) && defined(BITVECTOR_64BIT)
+      return __builtin_clzll(chunk);
+#elif defined(__GNUC__)
+      return __builtin_clz(chunk);
+#elif defined(_MSC_VER) && defined(BITVECTOR_64BIT) && defined(_WIN64)
+      unsigned long index;
+      _BitScanReverse64(&index, chunk);
+      return (BITS_IN_CHUNK-1) - (int32_t)index;
+#elif defined(_MSC_VER) && !defined(BITVECTOR_64BIT)
+      unsigned long index;
+      _BitScanReverse(&index, chunk);
+      return (BITS_IN_CHUNK-1) - (int32_t)index;
+#else
+      int32_t index = 0;
+      for (chunk_t mask = getBitMask(0); !(chunk & mask); mask = incrementBitMask(mask))
+         index++;
+      return index;
+#endif
+#else
+#if defined(__GNUC__) && defined(BITVECTOR_64BIT)
+      return __builtin_ctzll(chunk);
+#elif defined(__GNUC__)
+      return __builtin_ctz(chunk);
+#elif defined(_MSC_VER) && defined(BITVECTOR_64BIT) && defined(_WIN64)
+      unsigned long index;
+      _BitScanForward64(&index, chunk);
+      return (int32_t)index;
+#elif defined(_MSC_VER) && !defined(BITVECTOR_64BIT)
+      unsigned long index;
+      _BitScanForward(&index, chunk);
+      return (int32_t)index;
+#else
+      int32_t index = 0;
+      for (chunk_t mask = getBitMask(0); !(chunk & mask); mask = incrementBitMask(mask))
+         index++;
+      return index;
+#endif
+#endif
+      }
+
    // Re-allocate the chunk array so that there are enough chunks to handle the
    // given chunk index
    //
@@ -1036,9 +1193,7 @@ class TR_BitVectorIterator
       if (tmpChunk == ~(chunk_t) 0)
          return;
 
-      chunk_t  mask = TR_BitVector::getBitMask(_curIndex);
-      // zero the trailing bits from the chunk
-      //tmpChunk &= ~(mask - 1);
+      // zero the bits before the current one
       tmpChunk &= TR_BitVector::getBitMask(_curIndex, BITS_IN_CHUNK-1);
       if (!tmpChunk)
          {
@@ -1054,17 +1209,10 @@ class TR_BitVectorIterator
             curChunk++;
          } while(! _bitVector->_chunks[curChunk]);
          tmpChunk = _bitVector->_chunks[curChunk];
-         _curIndex = curChunk << SHIFT;
-         mask = TR_BitVector::getBitMask(0);
          }
       // here we are guaranteed to have a chunk with at least one bit set
 
-      //_curIndex = (_curIndex & ~(TR_BitVector::_numBitsChunk-1)) + TrailingZero(tmpChunk);
-      while (!(tmpChunk & mask)) // sequential check
-         {
-         _curIndex++;
-         mask = TR_BitVector::incrementBitMask(mask);
-         }
+      _curIndex = (curChunk << SHIFT) + TR_BitVector::getFirstBitIndexInChunk(tmpChunk);
       }
 
    TR_BitVector *_bitVector;
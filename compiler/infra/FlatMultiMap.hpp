@@ -0,0 +1,244 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef FLATMULTIMAP_HPP
+#define FLATMULTIMAP_HPP
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "env/Region.hpp"
+#include "infra/Assert.hpp"
+
+namespace TR {
+
+/**
+ * @brief An open-addressing multimap from 32-bit integer keys to values, allocated in a TR::Region.
+ *
+ * Entries live in a single flat array probed linearly, so lookups touch contiguous memory and
+ * inserts do not allocate until the table grows. No array is allocated until the first insert,
+ * since many users create a map per basic block and most of those stay small or empty. Removed entries become tombstones that are
+ * dropped the next time the table is rehashed. clear() is constant time: every slot carries the
+ * generation it was written in, and clearing simply starts a new generation.
+ *
+ * Entries sharing a key are visited in insertion order, which is the order std::multimap
+ * guarantees for equal keys.
+ */
+template <typename Value>
+class FlatMultiMap
+   {
+   struct Entry
+      {
+      int32_t _key;
+      uint32_t _stamp;
+      Value _value;
+      };
+
+public:
+
+   /**
+    * @brief Iterates over the entries with a given key, in insertion order.
+    *
+    * The map must not be inserted into while an iterator is in use; removing the current entry
+    * with remove() is allowed.
+    */
+   class KeyIterator
+      {
+   public:
+      KeyIterator(FlatMultiMap &map, int32_t key) :
+         _map(map),
+         _key(key),
+         _index(map.homeIndex(key))
+         {
+         findMatch();
+         }
+
+      bool atEnd() const { return !_map.isUsed(_index); }
+      Value &value() { return _map._entries[_index]._value; }
+      void next() { _index = _map.nextIndex(_index); findMatch(); }
+
+      /// Remove the current entry; the iterator stays positioned on it until next() is called
+      void remove() { _map.removeAt(_index); }
+
+   private:
+      void findMatch()
+         {
+         while (_map.isUsed(_index) && !_map.isLiveWithKey(_index, _key))
+            _index = _map.nextIndex(_index);
+         }
+
+      FlatMultiMap &_map;
+      int32_t _key;
+      uint32_t _index;
+      };
+
+   /**
+    * @param initialCapacity number of slots to allocate up front; by default nothing is allocated until the first insert
+    */
+   FlatMultiMap(TR::Region &region, uint32_t initialCapacity = 0) :
+      _region(region),
+      _entries(&_emptySlot),
+      _capacity(1),
+      _shift(32),
+      _size(0),
+      _used(0),
+      _generation(FIRST_GENERATION)
+      {
+      _emptySlot._stamp = 0;
+      if (initialCapacity > 0)
+         allocateEntries(initialCapacity);
+      }
+
+   uint32_t size() const { return _size; }
+   uint32_t capacity() const { return (_entries == &_emptySlot) ? 0 : _capacity; }
+   bool empty() const { return 0 == _size; }
+
+   void insert(int32_t key, const Value &value)
+      {
+      if ((_used + 1) * 4 > _capacity * 3)
+         rehash();
+
+      uint32_t index = homeIndex(key);
+      // Tombstones are not reused so that entries with equal keys stay in insertion order along the probe sequence
+      while (isUsed(index))
+         index = nextIndex(index);
+
+      Entry &entry = _entries[index];
+      entry._key = key;
+      entry._stamp = _generation;
+      entry._value = value;
+      _size += 1;
+      _used += 1;
+      }
+
+   /**
+    * @brief Remove every entry with the given key.
+    * @param[out] lastRemoved if not NULL and an entry was removed, receives the most recently inserted one
+    * @return the number of entries removed
+    */
+   uint32_t removeAll(int32_t key, Value *lastRemoved = NULL)
+      {
+      uint32_t removed = 0;
+      for (KeyIterator it(*this, key); !it.atEnd(); it.next())
+         {
+         if (NULL != lastRemoved)
+            *lastRemoved = it.value();
+         it.remove();
+         removed += 1;
+         }
+      return removed;
+      }
+
+   void clear()
+      {
+      _generation += GENERATION_STEP;
+      if (_generation < FIRST_GENERATION)
+         {
+         // The generation counter wrapped; stale stamps could now look current
+         memset(static_cast<void *>(_entries), 0, _capacity * sizeof(Entry));
+         _generation = FIRST_GENERATION;
+         }
+      _size = 0;
+      _used = 0;
+      }
+
+private:
+   friend class KeyIterator;
+
+   FlatMultiMap(const FlatMultiMap &); // not implemented: _entries may point into the object itself
+   FlatMultiMap &operator=(const FlatMultiMap &);
+
+   // A slot is live when its stamp is the current generation and a tombstone when it is the generation plus one
+   static const uint32_t FIRST_GENERATION = 2;
+   static const uint32_t GENERATION_STEP = 2;
+   static const uint32_t MIN_CAPACITY = 4;
+
+   bool isUsed(uint32_t index) const { return (_entries[index]._stamp - _generation) < GENERATION_STEP; }
+   bool isLive(uint32_t index) const { return _entries[index]._stamp == _generation; }
+   bool isLiveWithKey(uint32_t index, int32_t key) const { return isLive(index) && (_entries[index]._key == key); }
+
+   uint32_t homeIndex(int32_t key) const { return (uint32_t)((uint64_t)((uint32_t)key * 0x9E3779B1U) >> _shift); }
+   uint32_t nextIndex(uint32_t index) const { return (index + 1) & (_capacity - 1); }
+
+   void removeAt(uint32_t index)
+      {
+      TR_ASSERT(isLive(index), "removing an entry that is not live");
+      _entries[index]._stamp = _generation + 1;
+      _size -= 1;
+      }
+
+   void allocateEntries(uint32_t minimumCapacity)
+      {
+      uint32_t capacity = MIN_CAPACITY;
+      while (capacity < minimumCapacity)
+         capacity <<= 1;
+      _shift = 32;
+      for (uint32_t c = capacity; c > 1; c >>= 1)
+         _shift -= 1;
+      _entries = static_cast<Entry *>(_region.allocate(capacity * sizeof(Entry)));
+      memset(static_cast<void *>(_entries), 0, capacity * sizeof(Entry));
+      _capacity = capacity;
+      }
+
+   /**
+    * Rebuild the table without tombstones, doubling it if more than half of the slots hold live entries.
+    * This is also how the first real table replaces the empty slot.
+    * Old slots are visited starting just after an unused slot so that every run of equal keys is
+    * reinserted in its original order.
+    */
+   void rehash()
+      {
+      Entry *oldEntries = _entries;
+      uint32_t oldCapacity = _capacity;
+      uint32_t oldGeneration = _generation;
+      uint32_t start = 0;
+      while ((oldEntries[start]._stamp - oldGeneration) < GENERATION_STEP)
+         start += 1;
+
+      allocateEntries((_size * 2 > oldCapacity) ? (oldCapacity * 2) : oldCapacity);
+      _generation = FIRST_GENERATION;
+      _size = 0;
+      _used = 0;
+      for (uint32_t i = 1; i <= oldCapacity; i++)
+         {
+         Entry &entry = oldEntries[(start + i) & (oldCapacity - 1)];
+         if (entry._stamp == oldGeneration)
+            insert(entry._key, entry._value);
+         }
+      if (oldEntries != &_emptySlot)
+         _region.deallocate(oldEntries, oldCapacity * sizeof(Entry));
+      }
+
+   TR::Region &_region;
+   Entry *_entries;
+   uint32_t _capacity;
+   uint32_t _shift;
+   uint32_t _size;
+   uint32_t _used; ///< live entries plus tombstones
+   uint32_t _generation;
+   Entry _emptySlot; ///< stands in for the table until the first insert so that lookups need no special case
+   };
+
+}
+
+#endif
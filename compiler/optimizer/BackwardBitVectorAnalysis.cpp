@@ -21,6 +21,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include "compile/Compilation.hpp"
 #include "env/TRMemory.hpp"
 #include "il/Block.hpp"
@@ -49,6 +50,9 @@ template<class Container>void TR_BackwardDFSetAnalysis<Container *>::initializeD
    {
    this->initializeBasicDFSetAnalysis();
 
+   if (this->useWorklistSolver())
+      return;
+
    _currentOutSetInfo = (Container **)this->trMemory()->allocateStackMemory(this->_numberOfNodes*sizeof(Container *));
    _originalOutSetInfo = (Container **)this->trMemory()->allocateStackMemory(this->_numberOfNodes*sizeof(Container *));
 
@@ -1609,6 +1613,110 @@ template<class Container>void TR_BackwardDFSetAnalysis<Container *>::analyzeTree
    }
 
 
+template<class Container>bool TR_BackwardDFSetAnalysis<Container *>::solveWithWorklist()
+   {
+   TR::CFGNode **postorder = (TR::CFGNode **)this->trMemory()->allocateStackMemory(this->_numberOfNodes*sizeof(TR::CFGNode *));
+   int32_t numberOfBlocks = this->getWorklistOrder(postorder);
+
+   // Worklist positions are postorder so that, apart from back edges, every block is visited
+   // after all of its successors.
+   //
+   // For every block the compositions of the in sets of its regular and of its exception
+   // successors are kept separately, since the block's gen and kill sets are applied to them
+   // separately. Blocks without exception successors share one initial set.
+   //
+   int32_t *position = (int32_t *)this->trMemory()->allocateStackMemory(this->_numberOfNodes*sizeof(int32_t));
+   Container **regularOutSetInfo = (Container **)this->trMemory()->allocateStackMemory(this->_numberOfNodes*sizeof(Container *));
+   Container **exceptionOutSetInfo = (Container **)this->trMemory()->allocateStackMemory(this->_numberOfNodes*sizeof(Container *));
+   memset(regularOutSetInfo, 0, this->_numberOfNodes*sizeof(Container *));
+   memset(exceptionOutSetInfo, 0, this->_numberOfNodes*sizeof(Container *));
+
+   Container *noExceptionOutSetInfo = initializeInfo(NULL);
+   Container *exitOutSetInfo;
+   this->allocateContainer(&exitOutSetInfo);
+
+   TR_BitVector pendingBlocks(numberOfBlocks, this->trMemory()->currentStackRegion());
+   for (int32_t i = 0; i < numberOfBlocks; i++)
+      {
+      TR::Block *block = postorder[i]->asBlock();
+      int32_t blockNum = block->getNumber();
+      position[blockNum] = i;
+
+      // Nothing flows out of the method entry, and its info is not part of the result
+      if (blockNum == 0)
+         continue;
+
+      if (!this->_blockAnalysisInfo[blockNum])
+         this->allocateBlockInfoContainer(&this->_blockAnalysisInfo[blockNum]);
+      initializeInfo(this->_blockAnalysisInfo[blockNum]);
+      regularOutSetInfo[blockNum] = initializeInfo(NULL);
+      if (!block->getExceptionSuccessors().empty())
+         exceptionOutSetInfo[blockNum] = initializeInfo(NULL);
+      pendingBlocks.set(i);
+      }
+
+   int32_t numberOfVisits = 0;
+   while (!pendingBlocks.isEmpty())
+      {
+      for (int32_t p = 0; p < numberOfBlocks; p++)
+         {
+         if (!pendingBlocks.isSet(p))
+            continue;
+         pendingBlocks.reset(p);
+         numberOfVisits++;
+
+         TR::Block *block = postorder[p]->asBlock();
+         int32_t blockNum = block->getNumber();
+
+         if (block == this->_cfg->getEnd())
+            {
+            this->copyFromInto(exitOutSetInfo, this->_regularInfo);
+            this->copyFromInto(exitOutSetInfo, this->_exceptionInfo);
+            }
+         else
+            {
+            this->copyFromInto(regularOutSetInfo[blockNum], this->_regularInfo);
+            this->copyFromInto(exceptionOutSetInfo[blockNum] ? exceptionOutSetInfo[blockNum] : noExceptionOutSetInfo, this->_exceptionInfo);
+            }
+
+         if (this->_regularKillSetInfo[blockNum])
+            *this->_regularInfo -= *this->_regularKillSetInfo[blockNum];
+         if (this->_regularGenSetInfo[blockNum])
+            *this->_regularInfo |= *this->_regularGenSetInfo[blockNum];
+         if (this->_exceptionKillSetInfo[blockNum])
+            *this->_exceptionInfo -= *this->_exceptionKillSetInfo[blockNum];
+         if (this->_exceptionGenSetInfo[blockNum])
+            *this->_exceptionInfo |= *this->_exceptionGenSetInfo[blockNum];
+         compose(this->_regularInfo, this->_exceptionInfo);
+
+         Container *inSetInfo = this->_blockAnalysisInfo[blockNum];
+         if (*this->_regularInfo == *inSetInfo)
+            continue;
+         this->copyFromInto(this->_regularInfo, inSetInfo);
+
+         for (auto pred = block->getPredecessors().begin(); pred != block->getPredecessors().end(); ++pred)
+            {
+            int32_t predNum = (*pred)->getFrom()->getNumber();
+            if (regularOutSetInfo[predNum] &&
+                this->composeChanged(regularOutSetInfo[predNum], inSetInfo))
+               pendingBlocks.set(position[predNum]);
+            }
+         for (auto pred = block->getExceptionPredecessors().begin(); pred != block->getExceptionPredecessors().end(); ++pred)
+            {
+            int32_t predNum = (*pred)->getFrom()->getNumber();
+            if (exceptionOutSetInfo[predNum] &&
+                this->composeChanged(exceptionOutSetInfo[predNum], inSetInfo))
+               pendingBlocks.set(position[predNum]);
+            }
+         }
+      }
+
+   if (traceBBVA())
+      traceMsg(this->comp(), "\nWorklist solver made %d block visits over %d blocks\n", numberOfVisits, numberOfBlocks);
+
+   return true;
+   }
+
 template<class Container>void TR_BackwardDFSetAnalysis<Container *>::compose(Container *, Container *)
    {
    }
@@ -33,6 +33,11 @@ template<class Container>void TR_BackwardIntersectionDFSetAnalysis<Container *>:
    *firstBitVector &= *secondBitVector;
    }
 
+template<class Container>bool TR_BackwardIntersectionDFSetAnalysis<Container *>::composeChanged(Container *firstBitVector, Container *secondBitVector)
+   {
+   return firstBitVector->andChanged(*secondBitVector);
+   }
+
 
 template<class Container>void TR_BackwardIntersectionDFSetAnalysis<Container *>::inverseCompose(Container *firstBitVector, Container *secondBitVector)
    {
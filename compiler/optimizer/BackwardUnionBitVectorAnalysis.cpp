@@ -32,6 +32,11 @@ template<class Container>void TR_BackwardUnionDFSetAnalysis<Container *>::compos
    *firstBitVector |= *secondBitVector;
    }
 
+template<class Container>bool TR_BackwardUnionDFSetAnalysis<Container *>::composeChanged(Container *firstBitVector, Container *secondBitVector)
+   {
+   return firstBitVector->orChanged(*secondBitVector);
+   }
+
 template<class Container>void TR_BackwardUnionDFSetAnalysis<Container *>::inverseCompose(Container *firstBitVector, Container *secondBitVector)
    {
    *firstBitVector &= *secondBitVector;
@@ -34,6 +34,7 @@
 #include "infra/Cfg.hpp"
 #include "infra/Link.hpp"
 #include "infra/List.hpp"
+#include "infra/Stack.hpp"
 #include "infra/CfgEdge.hpp"
 #include "infra/CfgNode.hpp"
 #include "optimizer/Structure.hpp"
@@ -81,12 +82,19 @@ performAnalysis(TR_Structure *rootStructure,
    LexicalTimer tlex("basicDFSetAnalysis_pA", comp()->phaseTimer());
    //traceMsg(comp(), "DJS perform analysis %d, nodes = %d, bits = %d\n", this->getKind(), comp()->getFlowGraph()->getNextNodeNumber(), getNumberOfBits());
    // Table of bit vectors to be used during the analysis.
-   rootStructure->resetAnalysisInfo();
-   rootStructure->resetAnalyzedStatus();
+   bool worklist = useWorklistSolver();
+   if (!worklist)
+      {
+      rootStructure->resetAnalysisInfo();
+      rootStructure->resetAnalyzedStatus();
+      }
    initializeDFSetAnalysis();
    if (!postInitializationProcessing())
       return false;
-   doAnalysis(rootStructure, checkForChanges);
+   if (worklist)
+      solveWithWorklist();
+   else
+      doAnalysis(rootStructure, checkForChanges);
    //rootStructure->resetAnalysisInfo();
    //rootStructure->resetAnalyzedStatus();
    return true;
@@ -154,7 +162,11 @@ template<class Container>void TR_BasicDFSetAnalysis<Container *>::initializeBasi
    if (_blockAnalysisInfo == NULL)
       initializeBlockInfo();
 
-   _hasImproperRegion = _cfg->getStructure()->markStructuresWithImproperRegions();
+   // The worklist solver does not use the structure, so it has no use for improper region info
+   // or for gen and kill sets of regions
+   bool worklist = useWorklistSolver();
+   if (!worklist)
+      _hasImproperRegion = _cfg->getStructure()->markStructuresWithImproperRegions();
 
    if (comp()->getMethodSymbol()->mayHaveNestedLoops() &&
        !comp()->getOption(TR_DisableNewBVA))
@@ -190,7 +202,7 @@ template<class Container>void TR_BasicDFSetAnalysis<Container *>::initializeBasi
 
       initializeGenAndKillSetInfo();
 
-      if (!_hasImproperRegion)
+      if (!worklist && !_hasImproperRegion)
          {
          initializeGenAndKillSetInfoForStructures();
          if (traceBVA())
@@ -205,7 +217,8 @@ template<class Container>void TR_BasicDFSetAnalysis<Container *>::initializeBasi
       _exceptionKillSetInfo = NULL;
       }
 
-  _cfg->getStructure()->resetAnalyzedStatus();
+  if (!worklist)
+     _cfg->getStructure()->resetAnalyzedStatus();
 
   if (comp()->getVisitCount() > HIGH_VISIT_COUNT)
       {
@@ -216,6 +229,43 @@ template<class Container>void TR_BasicDFSetAnalysis<Container *>::initializeBasi
 
 
 
+template<class Container>int32_t TR_BasicDFSetAnalysis<Container *>::getWorklistOrder(TR::CFGNode **postorder)
+   {
+   TR_Stack<TR::CFGNode *> nodeStack(trMemory(), _numberOfNodes, false, stackAlloc);
+   TR_Stack<TR_SuccessorIterator *> iteratorStack(trMemory(), _numberOfNodes, false, stackAlloc);
+   TR_BitVector seenNodes(_numberOfNodes, trMemory()->currentStackRegion());
+   int32_t numberOfNodesInOrder = 0;
+
+   TR::CFGNode *start = _cfg->getStart();
+   seenNodes.set(start->getNumber());
+   nodeStack.push(start);
+   iteratorStack.push(new (trStackMemory()) TR_SuccessorIterator(start));
+
+   while (!nodeStack.isEmpty())
+      {
+      TR_SuccessorIterator *successors = iteratorStack.top();
+      TR::CFGEdge *edge = successors->getCurrent();
+      while (edge && seenNodes.isSet(edge->getTo()->getNumber()))
+         edge = successors->getNext();
+
+      if (edge)
+         {
+         TR::CFGNode *succ = edge->getTo();
+         seenNodes.set(succ->getNumber());
+         nodeStack.push(succ);
+         iteratorStack.push(new (trStackMemory()) TR_SuccessorIterator(succ));
+         }
+      else
+         {
+         postorder[numberOfNodesInOrder++] = nodeStack.pop();
+         iteratorStack.pop();
+         }
+      }
+
+   return numberOfNodesInOrder;
+   }
+
+
 template<class Container>void TR_BasicDFSetAnalysis<Container *>::initializeGenAndKillSetInfoForStructures()
    {
    initializeGenAndKillSetInfoPropertyForStructure(_cfg->getStructure(), false);
@@ -1106,9 +1156,7 @@ template<class Container>bool TR_ForwardDFSetAnalysis<Container *>::analyzeRegio
             {
             if (this->getKind() == TR_DataFlowAnalysis::ReachingDefinitions)
                {
-               *this->_temp = *fromBitVector;
-               *this->_temp -= *toBitVector;
-               if (!this->_temp->isEmpty())
+               if (!fromBitVector->isSubsetOf(*toBitVector))
                  {
                  dumpOptDetails(this->comp(), "From %d\n", edgeFrom->getNumber());
                  dumpOptDetails(this->comp(), "To %d\n", toStructureNumber);
@@ -1129,10 +1177,7 @@ template<class Container>bool TR_ForwardDFSetAnalysis<Container *>::analyzeRegio
                }
             else
                {
-               if (checkForChange && !changed)
-                  *this->_temp = *toBitVector;
-               this->compose(toBitVector, fromBitVector);
-               if (checkForChange && !changed && !(*this->_temp == *toBitVector))
+               if (this->composeChanged(toBitVector, fromBitVector) && checkForChange)
                   changed = true;
                }
             }
@@ -1553,6 +1598,85 @@ template<class Container>void TR_ForwardDFSetAnalysis<Container *>::analyzeTreeT
    }
 
 
+template<class Container>bool TR_ForwardDFSetAnalysis<Container *>::solveWithWorklist()
+   {
+   TR::CFGNode **postorder = (TR::CFGNode **)this->trMemory()->allocateStackMemory(this->_numberOfNodes*sizeof(TR::CFGNode *));
+   int32_t numberOfBlocks = this->getWorklistOrder(postorder);
+
+   // Worklist positions are reverse postorder so that, apart from back edges, every block is
+   // visited after all of its predecessors
+   int32_t *position = (int32_t *)this->trMemory()->allocateStackMemory(this->_numberOfNodes*sizeof(int32_t));
+   TR_BitVector pendingBlocks(numberOfBlocks, this->trMemory()->currentStackRegion());
+   for (int32_t i = 0; i < numberOfBlocks; i++)
+      {
+      int32_t blockNum = postorder[i]->getNumber();
+      position[blockNum] = numberOfBlocks - 1 - i;
+      if (!this->_blockAnalysisInfo[blockNum])
+         this->allocateBlockInfoContainer(&this->_blockAnalysisInfo[blockNum]);
+      initializeInfo(this->_blockAnalysisInfo[blockNum]);
+      pendingBlocks.set(i);
+      }
+
+   // The in set of a block is the composition of the out sets of its predecessors. Out sets are
+   // not kept: each time a block is visited its out sets are composed into the in sets of its
+   // successors, and a successor is queued again only if that changed its in set.
+   //
+   int32_t numberOfVisits = 0;
+   while (!pendingBlocks.isEmpty())
+      {
+      for (int32_t p = 0; p < numberOfBlocks; p++)
+         {
+         if (!pendingBlocks.isSet(p))
+            continue;
+         pendingBlocks.reset(p);
+         numberOfVisits++;
+
+         TR::Block *block = postorder[numberOfBlocks - 1 - p]->asBlock();
+         int32_t blockNum = block->getNumber();
+         Container *inSetInfo = this->_blockAnalysisInfo[blockNum];
+
+         initializeInfo(this->_regularInfo);
+         initializeInfo(this->_exceptionInfo);
+         if (blockNum == 0)
+            {
+            this->copyFromInto(inSetInfo, _currentInSetInfo);
+            analyzeBlockZeroStructure(block->getStructureOf());
+            }
+         else
+            {
+            this->copyFromInto(inSetInfo, this->_regularInfo);
+            this->copyFromInto(inSetInfo, this->_exceptionInfo);
+            if (this->_regularKillSetInfo[blockNum])
+               *this->_regularInfo -= *this->_regularKillSetInfo[blockNum];
+            if (this->_regularGenSetInfo[blockNum])
+               *this->_regularInfo |= *this->_regularGenSetInfo[blockNum];
+            if (this->_exceptionKillSetInfo[blockNum])
+               *this->_exceptionInfo -= *this->_exceptionKillSetInfo[blockNum];
+            if (this->_exceptionGenSetInfo[blockNum])
+               *this->_exceptionInfo |= *this->_exceptionGenSetInfo[blockNum];
+            }
+
+         for (auto succ = block->getSuccessors().begin(); succ != block->getSuccessors().end(); ++succ)
+            {
+            int32_t succNum = (*succ)->getTo()->getNumber();
+            if (this->composeChanged(this->_blockAnalysisInfo[succNum], this->_regularInfo))
+               pendingBlocks.set(position[succNum]);
+            }
+         for (auto succ = block->getExceptionSuccessors().begin(); succ != block->getExceptionSuccessors().end(); ++succ)
+            {
+            int32_t succNum = (*succ)->getTo()->getNumber();
+            if (this->composeChanged(this->_blockAnalysisInfo[succNum], this->_exceptionInfo))
+               pendingBlocks.set(position[succNum]);
+            }
+         }
+      }
+
+   if (this->traceBVA())
+      traceMsg(this->comp(), "\nWorklist solver made %d block visits over %d blocks\n", numberOfVisits, numberOfBlocks);
+
+   return true;
+   }
+
 template<class Container>void TR_ForwardDFSetAnalysis<Container *>::compose(Container *, Container *)
    {
    }
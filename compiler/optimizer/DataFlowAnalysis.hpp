@@ -266,6 +266,16 @@ template<class Container>class TR_BasicDFSetAnalysis<Container *> :
    virtual void compose(Container *, Container *) {}
    virtual void inverseCompose(Container *, Container *) {}
 
+   // Compose the second container into the first one and return true if the first one changed.
+   // Analyses whose composition maps onto a single container operation override this with the
+   // fused container kernel so that no copy and compare is needed.
+   virtual bool composeChanged(Container *first, Container *second)
+      {
+      *_temp = *first;
+      compose(first, second);
+      return !(*_temp == *first);
+      }
+
    void initializeBlockInfo(bool allocateLater = false);
 
    // Perform the analysis including initialization
@@ -281,6 +291,25 @@ template<class Container>class TR_BasicDFSetAnalysis<Container *> :
       return rootStructure->doDataFlowAnalysis(this, checkForChanges);
       }
 
+   // Analyses can opt into a worklist solver that works on the CFG instead of the structure tree.
+   // It visits blocks in reverse postorder (postorder for backward analyses) and only revisits a
+   // block when the set flowing into it changed. It needs gen and kill sets and only computes the
+   // per-block results in _blockAnalysisInfo; the structure analysis info is left untouched, so an
+   // analysis may only opt in when nothing reads the per-structure results.
+   virtual bool supportsWorklistSolver() {return false;}
+
+   bool useWorklistSolver()
+      {
+      return supportsWorklistSolver() &&
+             supportsGenAndKillSets() &&
+             !comp()->getOption(TR_DisableWorklistDataFlow);
+      }
+
+   virtual bool solveWithWorklist() = 0;
+
+   // Fill the given array with the nodes reachable from the CFG start in postorder and return how many there are
+   int32_t getWorklistOrder(TR::CFGNode **postorder);
+
    virtual void initializeDFSetAnalysis() = 0;
 
    class TR_ContainerNodeNumberPair : public TR_Link<TR_ContainerNodeNumberPair>
@@ -385,6 +414,7 @@ template<class Container>class TR_ForwardDFSetAnalysis<Container *> :
    virtual bool analyzeBlockStructure(TR_BlockStructure *, bool);
    virtual void analyzeBlockZeroStructure(TR_BlockStructure *);
    virtual bool analyzeRegionStructure(TR_RegionStructure *, bool);
+   virtual bool solveWithWorklist();
 
    virtual void compose(Container *, Container *);
    virtual void inverseCompose(Container *, Container *);
@@ -423,6 +453,7 @@ template<class Container>class TR_IntersectionDFSetAnalysis<Container *> :
    virtual TR_DataFlowAnalysis::Kind getKind();
 
    virtual void compose(Container *, Container *);
+   virtual bool composeChanged(Container *, Container *);
    virtual void inverseCompose(Container *, Container *);
    virtual void initializeInSetInfo();
    virtual void initializeCurrentGenKillSetInfo();
@@ -454,6 +485,7 @@ template<class Container>class TR_UnionDFSetAnalysis<Container *> : public TR_Fo
    virtual TR_DataFlowAnalysis::Kind getKind();
 
    virtual void compose(Container *, Container *);
+   virtual bool composeChanged(Container *, Container *);
    virtual void inverseCompose(Container *, Container *);
    virtual void initializeInSetInfo();
    virtual void initializeCurrentGenKillSetInfo();
@@ -493,6 +525,7 @@ class TR_ReachingDefinitions : public TR_UnionBitVectorAnalysis
    virtual void analyzeBlockZeroStructure(TR_BlockStructure *);
    virtual bool supportsGenAndKillSets();
    virtual void initializeGenAndKillSetInfo();
+   virtual bool supportsWorklistSolver();
 
    private:
 
@@ -527,6 +560,7 @@ template<class Container>class TR_BackwardDFSetAnalysis<Container *> :
 
    virtual bool analyzeBlockStructure(TR_BlockStructure *, bool);
    virtual bool analyzeRegionStructure(TR_RegionStructure *, bool);
+   virtual bool solveWithWorklist();
 
    virtual void compose(Container *, Container *);
    virtual void inverseCompose(Container *, Container *) {}
@@ -566,6 +600,7 @@ template<class Container>class TR_BackwardIntersectionDFSetAnalysis<Container *>
    virtual TR_DataFlowAnalysis::Kind getKind();
 
    virtual void compose(Container *, Container *);
+   virtual bool composeChanged(Container *, Container *);
    virtual void inverseCompose(Container *, Container *);
    virtual void initializeOutSetInfo();
    virtual Container * initializeInfo(Container *);
@@ -595,6 +630,7 @@ template<class Container>class TR_BackwardUnionDFSetAnalysis<Container *> :
    virtual TR_DataFlowAnalysis::Kind getKind();
 
    virtual void compose(Container *, Container *);
+   virtual bool composeChanged(Container *, Container *);
    virtual void inverseCompose(Container *, Container *);
    virtual void initializeOutSetInfo();
    virtual Container * initializeInfo(Container *);
@@ -863,6 +899,7 @@ class TR_Liveness : public TR_BackwardUnionBitVectorAnalysis
    virtual int32_t getNumberOfBits();
    virtual bool supportsGenAndKillSets();
    virtual void initializeGenAndKillSetInfo();
+   virtual bool supportsWorklistSolver();
    virtual void analyzeNode(TR::Node *, vcount_t, TR_BlockStructure *, TR_BitVector *);
    virtual void analyzeTreeTopsInBlockStructure(TR_BlockStructure *);
    virtual bool postInitializationProcessing();
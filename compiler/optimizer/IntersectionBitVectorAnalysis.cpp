@@ -29,6 +29,11 @@ template<class Container>void TR_IntersectionDFSetAnalysis<Container *>::compose
    *firstBitVector &= *secondBitVector;
    }
 
+template<class Container>bool TR_IntersectionDFSetAnalysis<Container *>::composeChanged(Container *firstBitVector, Container *secondBitVector)
+   {
+   return firstBitVector->andChanged(*secondBitVector);
+   }
+
 template<class Container>void TR_IntersectionDFSetAnalysis<Container *>::inverseCompose(Container *firstBitVector, Container *secondBitVector)
    {
    *firstBitVector |= *secondBitVector;
@@ -50,6 +50,12 @@ bool TR_Liveness::supportsGenAndKillSets()
    return true;
    }
 
+// Only the per-block results are used, so the structure tree does not need to be walked
+bool TR_Liveness::supportsWorklistSolver()
+   {
+   return true;
+   }
+
 int32_t TR_Liveness::getNumberOfBits()
    {
    return _liveVariableInfo->numLocals();
@@ -313,10 +313,10 @@ void OMR::LocalCSE::transformBlock(TR::TreeTop * entryTree, TR::TreeTop * exitTr
    memset(_replacedNodesAsArray, 0, _numNodes*sizeof(TR::Node*));
    memset(_replacedNodesByAsArray, 0, _numNodes*sizeof(TR::Node*));
 
-   _hashTable = new (stackMemoryRegion) HashTable(std::less<int32_t>(), stackMemoryRegion);
-   _hashTableWithSyms = new (stackMemoryRegion) HashTable(std::less<int32_t>(), stackMemoryRegion);
-   _hashTableWithCalls = new (stackMemoryRegion) HashTable(std::less<int32_t>(), stackMemoryRegion);
-   _hashTableWithConsts = new (stackMemoryRegion) HashTable(std::less<int32_t>(), stackMemoryRegion);
+   _hashTable = new (stackMemoryRegion) HashTable(stackMemoryRegion);
+   _hashTableWithSyms = new (stackMemoryRegion) HashTable(stackMemoryRegion);
+   _hashTableWithCalls = new (stackMemoryRegion) HashTable(stackMemoryRegion);
+   _hashTableWithConsts = new (stackMemoryRegion) HashTable(stackMemoryRegion);
 
    _nextReplacedNode = 0;
    TR_BitVector seenAvailableLoadedSymbolReferences(stackMemoryRegion);
@@ -1314,11 +1314,9 @@ TR::Node* OMR::LocalCSE::getAvailableExpression(TR::Node *parent, TR::Node *node
       hashTable = _hashTable;
 
    int32_t hashValue = hash(parent, node);
-   auto range = hashTable->equal_range(hashValue);
-
-   for(auto it = range.first; it != range.second;)
+   for (HashTable::KeyIterator it(*hashTable, hashValue); !it.atEnd(); it.next())
       {
-      TR::Node *other = it->second;
+      TR::Node *other = it.value();
       bool remove = false;
       if (areSyntacticallyEquivalent(other, node, &remove))
          {
@@ -1331,16 +1329,9 @@ TR::Node* OMR::LocalCSE::getAvailableExpression(TR::Node *parent, TR::Node *node
          {
          if (trace())
             traceMsg(comp(), "remove is true, removing entry %p\n", other);
-         auto nextIt = it;
-         ++nextIt;
-         hashTable->erase(it);
-         it = nextIt;
+         it.remove();
          _killedNodes.set(other->getGlobalIndex());
          }
-      else
-         {
-         ++it;
-         }
       }
 
    if (node->hasPinningArrayPointer() &&
@@ -1468,15 +1459,9 @@ void OMR::LocalCSE::killAvailableExpressionsUsingBitVector(HashTable *hashTable,
    while (bvi.hasMoreElements())
       {
       int32_t nextSymRefNum = bvi.getNextElement();
-      auto range = hashTable->equal_range(nextSymRefNum);
-      if (range.first != range.second)
-         {
-         auto lastItem = range.second;
-         --lastItem;
-         _killedNodes.set(lastItem->second->getGlobalIndex());
-
-         hashTable->erase(range.first, range.second);
-         }
+      TR::Node *lastItem = NULL;
+      if (hashTable->removeAll(nextSymRefNum, &lastItem) > 0)
+         _killedNodes.set(lastItem->getGlobalIndex());
       }
    }
 
@@ -1674,32 +1659,29 @@ void OMR::LocalCSE::addToHashTable(TR::Node *node, int32_t hashValue)
       _arrayRefNodes->add(node);
       }
 
-   auto pair = std::make_pair(hashValue, node);
-
    if (node->getOpCode().hasSymbolReference() && ((node->getOpCodeValue() != TR::loadaddr) || _loadaddrAsLoad))
       {
       if (node->getOpCode().isCall())
          {
-         _hashTableWithCalls->insert(pair);
+         _hashTableWithCalls->insert(hashValue, node);
          _availableCallExprs.set(node->getSymbolReference()->getReferenceNumber());
          }
       else
          {
-         _hashTableWithSyms->insert(pair);
+         _hashTableWithSyms->insert(hashValue, node);
          _availableLoadExprs.set(node->getSymbolReference()->getReferenceNumber());
          }
       }
    else if (node->getOpCode().isLoadConst())
-      _hashTableWithConsts->insert(pair);
+      _hashTableWithConsts->insert(hashValue, node);
    else
-      _hashTable->insert(pair);
+      _hashTable->insert(hashValue, node);
    }
 
 
 void OMR::LocalCSE::removeFromHashTable(HashTable *hashTable, int32_t hashValue)
    {
-   auto range = hashTable->equal_range(hashValue);
-   hashTable->erase(range.first, range.second);
+   hashTable->removeAll(hashValue);
    }
 
 
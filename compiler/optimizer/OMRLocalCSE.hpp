@@ -32,6 +32,7 @@
 #include "il/Node.hpp"
 #include "il/SymbolReference.hpp"
 #include "infra/Array.hpp"
+#include "infra/FlatMultiMap.hpp"
 #include "infra/List.hpp"
 #include "optimizer/Optimization.hpp"
 
@@ -84,8 +85,7 @@ class LocalCSE : public TR::Optimization
    virtual void postPerformOnBlocks();
    virtual const char * optDetailString() const throw();
 
-   typedef TR::typed_allocator< std::pair< const int32_t, TR::Node* >, TR::Region & > HashTableAllocator;
-   typedef std::multimap< int32_t, TR::Node*, std::less<int32_t>, HashTableAllocator > HashTable;
+   typedef TR::FlatMultiMap<TR::Node *> HashTable;
 
    protected:
 
@@ -55,6 +55,12 @@ bool TR_ReachingDefinitions::supportsGenAndKillSets()
    return true;
    }
 
+// Only the per-block results are used, so the structure tree does not need to be walked
+bool TR_ReachingDefinitions::supportsWorklistSolver()
+   {
+   return true;
+   }
+
 
 TR_ReachingDefinitions::TR_ReachingDefinitions(TR::Compilation *comp, TR::CFG *cfg, TR::Optimizer *optimizer, TR_UseDefInfo *useDefInfo, TR_UseDefInfo::AuxiliaryData &aux, bool trace)
    : TR_UnionBitVectorAnalysis(comp, cfg, optimizer, trace),
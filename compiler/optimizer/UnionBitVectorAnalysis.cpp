@@ -35,6 +35,11 @@ template<class Container>void TR_UnionDFSetAnalysis<Container *>::compose(Contai
    *firstBitVector |= *secondBitVector;
    }
 
+template<class Container>bool TR_UnionDFSetAnalysis<Container *>::composeChanged(Container *firstBitVector, Container *secondBitVector)
+   {
+   return firstBitVector->orChanged(*secondBitVector);
+   }
+
 template<class Container>void TR_UnionDFSetAnalysis<Container *>::inverseCompose(Container *firstBitVector, Container *secondBitVector)
    {
    *firstBitVector &= *secondBitVector;
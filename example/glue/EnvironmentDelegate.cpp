@@ -55,6 +55,7 @@ MM_EnvironmentDelegate::acquireVMAccess()
 {
 	OMR_VM_Example *exampleVM = (OMR_VM_Example *)_env->getOmrVM()->_language_vm;
 	omrthread_rwmutex_enter_read(exampleVM->_vmAccessMutex);
+	_hasVMAccess = true;
 }
 
 /**
@@ -64,6 +65,7 @@ void
 MM_EnvironmentDelegate::releaseVMAccess()
 {
 	OMR_VM_Example *exampleVM = (OMR_VM_Example *)_env->getOmrVM()->_language_vm;
+	_hasVMAccess = false;
 	omrthread_rwmutex_exit_read(exampleVM->_vmAccessMutex);
 }
 
@@ -103,8 +105,21 @@ MM_EnvironmentDelegate::acquireExclusiveVMAccess()
 		/* tell the rest of the world that a thread is going for exclusive VM< access */
 		MM_AtomicOperations::add(&exampleVM->_vmExclusiveAccessCount, 1);
 
+		/* a mutator allocating with shared VM access must give it up before it can acquire exclusive VM access */
+		if (_hasVMAccess) {
+			releaseVMAccess();
+			_releasedVMAccessForExclusive = true;
+		}
+
 		/* unconditionally acquire exclusive VM access by locking the VM thread list mutex */
 		omrthread_rwmutex_enter_write(exampleVM->_vmAccessMutex);
+
+		/* let any thread that just released exclusive VM access reclaim its shared VM access first */
+		while (0 < exampleVM->_vmAccessReacquireCount) {
+			omrthread_rwmutex_exit_write(exampleVM->_vmAccessMutex);
+			omrthread_yield();
+			omrthread_rwmutex_enter_write(exampleVM->_vmAccessMutex);
+		}
 		omrthread_monitor_enter(omrVM->_vmThreadListMutex);
 	}
 	_env->getOmrVMThread()->exclusiveCount += 1;
@@ -121,10 +136,20 @@ MM_EnvironmentDelegate::releaseExclusiveVMAccess()
 	if (1 == _env->getOmrVMThread()->exclusiveCount) {
 		OMR_VM_Example *exampleVM = (OMR_VM_Example *)_env->getOmrVM()->_language_vm;
 		omrthread_monitor_exit(_env->getOmrVM()->_vmThreadListMutex);
+		if (_releasedVMAccessForExclusive) {
+			/* objects allocated under exclusive VM access are not yet reachable, so no other thread
+			 * may acquire exclusive VM access before this thread has reclaimed shared VM access */
+			MM_AtomicOperations::add(&exampleVM->_vmAccessReacquireCount, 1);
+		}
 		omrthread_rwmutex_exit_write(exampleVM->_vmAccessMutex);
 		Assert_MM_true(0 < exampleVM->_vmExclusiveAccessCount);
 		MM_AtomicOperations::subtract(&exampleVM->_vmExclusiveAccessCount, 1);
 		_env->getOmrVMThread()->exclusiveCount -= 1;
+		if (_releasedVMAccessForExclusive) {
+			_releasedVMAccessForExclusive = false;
+			acquireVMAccess();
+			MM_AtomicOperations::subtract(&exampleVM->_vmAccessReacquireCount, 1);
+		}
 	} else if (1 < _env->getOmrVMThread()->exclusiveCount) {
 		_env->getOmrVMThread()->exclusiveCount -= 1;
 	}
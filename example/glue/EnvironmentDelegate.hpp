@@ -83,6 +83,8 @@ class MM_EnvironmentDelegate
 private:
 	MM_EnvironmentBase *_env;
 	GC_Environment _gcEnv;
+	bool _hasVMAccess; /**< true while this thread holds shared VM access */
+	bool _releasedVMAccessForExclusive; /**< true if shared VM access was released to acquire exclusive VM access */
 
 protected:
 
@@ -121,6 +123,8 @@ public:
 	initialize(MM_EnvironmentBase *env)
 	{
 		_env = env;
+		_hasVMAccess = false;
+		_releasedVMAccessForExclusive = false;
 		return true;
 	}
 
@@ -224,9 +228,35 @@ public:
 	 */
 	void assumeExclusiveVMAccess(uintptr_t exclusiveCount);
 
-	void releaseCriticalHeapAccess(uintptr_t *data) {}
+	/**
+	 * Release shared VM access while waiting for another thread to complete a GC. A thread
+	 * holding shared VM access would otherwise prevent the GC thread from acquiring exclusive
+	 * VM access.
+	 *
+	 * @param[out] data set to nonzero if shared VM access was released
+	 * @see reacquireCriticalHeapAccess(uintptr_t)
+	 */
+	void
+	releaseCriticalHeapAccess(uintptr_t *data)
+	{
+		*data = _hasVMAccess ? 1 : 0;
+		if (_hasVMAccess) {
+			releaseVMAccess();
+		}
+	}
 
-	void reacquireCriticalHeapAccess(uintptr_t data) {}
+	/**
+	 * Reacquire shared VM access released by releaseCriticalHeapAccess().
+	 *
+	 * @param[in] data the value set by releaseCriticalHeapAccess()
+	 */
+	void
+	reacquireCriticalHeapAccess(uintptr_t data)
+	{
+		if (0 != data) {
+			acquireVMAccess();
+		}
+	}
 
 #if defined(OMR_GC_CONCURRENT_SCAVENGER)
 	void forceOutOfLineVMAccess() {}
@@ -34,6 +34,7 @@ typedef struct OMR_VM_Example {
 	omrthread_t self;
 	omrthread_rwmutex_t _vmAccessMutex;
 	volatile uintptr_t _vmExclusiveAccessCount;
+	volatile uintptr_t _vmAccessReacquireCount;
 } OMR_VM_Example;
 
 typedef struct RootEntry {
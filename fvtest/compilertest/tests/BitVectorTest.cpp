@@ -0,0 +1,243 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include <algorithm>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <vector>
+#include "env/RawAllocator.hpp"
+#include "env/Region.hpp"
+#include "env/SystemSegmentProvider.hpp"
+#include "infra/BitVector.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+class BitVectorTest : public ::testing::Test
+   {
+protected:
+   BitVectorTest() :
+      _segmentProvider(1 << 16, _rawAllocator),
+      _region(_segmentProvider, _rawAllocator),
+      _seed(12345)
+      {
+      }
+
+   uint32_t random()
+      {
+      _seed = _seed * 1103515245 + 12345;
+      return (_seed >> 8) & 0xffffff;
+      }
+
+   // Fill a vector with roughly one bit in every 'sparseness' inside [low, high)
+   void fill(TR_BitVector &v, int32_t low, int32_t high, int32_t sparseness)
+      {
+      for (int32_t i = low; i < high; i++)
+         if (random() % sparseness == 0)
+            v.set(i);
+      }
+
+   bool sameBits(TR_BitVector &a, TR_BitVector &b, int32_t numBits)
+      {
+      for (int32_t i = 0; i < numBits; i++)
+         if (a.isSet(i) != b.isSet(i))
+            return false;
+      return true;
+      }
+
+   TR::RawAllocator _rawAllocator;
+   TR::SystemSegmentProvider _segmentProvider;
+   TR::Region _region;
+   uint32_t _seed;
+   };
+
+TEST_F(BitVectorTest, IteratorVisitsEverySetBit)
+   {
+   const int32_t numBits = 1000;
+   for (int32_t sparseness = 1; sparseness < 200; sparseness *= 3)
+      {
+      TR_BitVector v(numBits, _region);
+      fill(v, 0, numBits, sparseness);
+      v.set(numBits - 1);
+
+      std::vector<int32_t> expected;
+      for (int32_t i = 0; i < numBits; i++)
+         if (v.isSet(i))
+            expected.push_back(i);
+
+      std::vector<int32_t> visited;
+      TR_BitVectorIterator bvi(v);
+      while (bvi.hasMoreElements())
+         visited.push_back(bvi.getNextElement());
+      EXPECT_EQ(expected, visited) << "sparseness " << sparseness;
+
+      TR_BitVectorIterator fromMiddle(v, 500);
+      if (fromMiddle.hasMoreElements())
+         EXPECT_EQ(*std::lower_bound(expected.begin(), expected.end(), 500), fromMiddle.getNextElement());
+      }
+
+   TR_BitVector empty(numBits, _region);
+   TR_BitVectorIterator bvi(empty);
+   EXPECT_FALSE(bvi.hasMoreElements());
+   }
+
+TEST_F(BitVectorTest, FusedKernelsMatchSeparateOperations)
+   {
+   const int32_t numBits = 700;
+   for (int32_t round = 0; round < 200; round++)
+      {
+      TR_BitVector a(numBits, _region);
+      TR_BitVector b(numBits, _region);
+      // Vary the populated ranges so that the chunk range handling is covered
+      fill(a, random() % numBits, numBits, 1 + round % 7);
+      fill(b, 0, random() % numBits, 1 + round % 5);
+      if (round % 4 == 0)
+         a = b;
+
+      TR_BitVector expected(a);
+      expected |= b;
+      TR_BitVector actual(a);
+      EXPECT_EQ(!(expected == a), actual.orChanged(b));
+      EXPECT_TRUE(expected == actual);
+      EXPECT_TRUE(sameBits(expected, actual, numBits));
+
+      expected = a;
+      expected &= b;
+      actual = a;
+      EXPECT_EQ(!(expected == a), actual.andChanged(b));
+      EXPECT_TRUE(expected == actual);
+      EXPECT_TRUE(sameBits(expected, actual, numBits));
+
+      TR_BitVector difference(a);
+      difference -= b;
+      EXPECT_EQ(difference.isEmpty(), a.isSubsetOf(b));
+      EXPECT_TRUE(expected.isSubsetOf(a));
+      EXPECT_TRUE(expected.isSubsetOf(b));
+      }
+   }
+
+TEST_F(BitVectorTest, SingleBitContainerKernels)
+   {
+   for (int32_t bits = 0; bits < 4; bits++)
+      {
+      TR_SingleBitContainer a, b;
+      if (bits & 1) a.set();
+      if (bits & 2) b.set();
+      bool aValue = a.get(), bValue = b.get();
+
+      TR_SingleBitContainer c;
+      c = a;
+      EXPECT_EQ(!aValue && bValue, c.orChanged(b));
+      EXPECT_EQ(aValue || bValue, (bool)c.get());
+      c = a;
+      EXPECT_EQ(aValue && !bValue, c.andChanged(b));
+      EXPECT_EQ(aValue && bValue, (bool)c.get());
+      EXPECT_EQ(!aValue || bValue, a.isSubsetOf(b));
+      }
+   }
+
+/**
+ * Runs a union data flow sweep to a fixed point over the bit vectors of a large method,
+ * once composing with a copy, an OR and a compare as the analyses used to, and once with
+ * the fused kernel, then iterates the resulting sets.
+ */
+TEST_F(BitVectorTest, UnionSweepOnLargeMethod)
+   {
+   const int32_t numBlocks = 2000;
+   const int32_t numBits = 20000;
+
+   std::vector<TR_BitVector *> gen(numBlocks);
+   std::vector<TR_BitVector *> separateOut(numBlocks);
+   std::vector<TR_BitVector *> fusedOut(numBlocks);
+   for (int32_t b = 0; b < numBlocks; b++)
+      {
+      gen[b] = new (_region) TR_BitVector(numBits, _region);
+      int32_t low = (int32_t)(((int64_t)b * numBits) / numBlocks);
+      fill(*gen[b], low, low + numBits / 20 < numBits ? low + numBits / 20 : numBits, 8);
+      separateOut[b] = new (_region) TR_BitVector(numBits, _region);
+      fusedOut[b] = new (_region) TR_BitVector(numBits, _region);
+      }
+
+   TR_BitVector temp(numBits, _region);
+   int32_t separateSweeps = 0;
+   clock_t separateStart = clock();
+   for (bool changed = true; changed; separateSweeps++)
+      {
+      changed = false;
+      for (int32_t b = 0; b < numBlocks; b++)
+         {
+         int32_t pred = (b * 7 + 3) % numBlocks;
+         temp = *separateOut[b];
+         *separateOut[b] |= *separateOut[pred];
+         *separateOut[b] |= *gen[b];
+         if (!(temp == *separateOut[b]))
+            changed = true;
+         }
+      }
+   double separateSeconds = (double)(clock() - separateStart) / CLOCKS_PER_SEC;
+
+   int32_t fusedSweeps = 0;
+   clock_t fusedStart = clock();
+   for (bool changed = true; changed; fusedSweeps++)
+      {
+      changed = false;
+      for (int32_t b = 0; b < numBlocks; b++)
+         {
+         int32_t pred = (b * 7 + 3) % numBlocks;
+         if (fusedOut[b]->orChanged(*fusedOut[pred]))
+            changed = true;
+         if (fusedOut[b]->orChanged(*gen[b]))
+            changed = true;
+         }
+      }
+   double fusedSeconds = (double)(clock() - fusedStart) / CLOCKS_PER_SEC;
+
+   int64_t bitByBitCount = 0;
+   clock_t bitByBitStart = clock();
+   for (int32_t b = 0; b < numBlocks; b += 10)
+      for (int32_t i = 0; i < numBits; i++)
+         if (gen[b]->isSet(i))
+            bitByBitCount += i;
+   double bitByBitSeconds = (double)(clock() - bitByBitStart) / CLOCKS_PER_SEC;
+
+   int64_t iteratorCount = 0;
+   clock_t iteratorStart = clock();
+   for (int32_t b = 0; b < numBlocks; b += 10)
+      {
+      TR_BitVectorIterator bvi(*gen[b]);
+      while (bvi.hasMoreElements())
+         iteratorCount += bvi.getNextElement();
+      }
+   double iteratorSeconds = (double)(clock() - iteratorStart) / CLOCKS_PER_SEC;
+
+   printf("Union sweep over %d blocks x %d bits: copy/or/compare %.3fs (%d sweeps), fused %.3fs (%d sweeps)\n",
+      numBlocks, numBits, separateSeconds, separateSweeps, fusedSeconds, fusedSweeps);
+   printf("Sparse iteration: bit by bit %.3fs, iterator %.3fs\n", bitByBitSeconds, iteratorSeconds);
+
+   EXPECT_EQ(separateSweeps, fusedSweeps);
+   for (int32_t b = 0; b < numBlocks; b++)
+      EXPECT_TRUE(*separateOut[b] == *fusedOut[b]);
+   EXPECT_EQ(bitByBitCount, iteratorCount);
+   }
+
+}
@@ -0,0 +1,238 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+#include <map>
+#include <vector>
+#include "env/RawAllocator.hpp"
+#include "env/Region.hpp"
+#include "env/SystemSegmentProvider.hpp"
+#include "env/TypedAllocator.hpp"
+#include "infra/FlatMultiMap.hpp"
+#include "gtest/gtest.h"
+
+namespace {
+
+class FlatMultiMapTest : public ::testing::Test
+   {
+protected:
+   FlatMultiMapTest() :
+      _segmentProvider(1 << 16, _rawAllocator),
+      _region(_segmentProvider, _rawAllocator)
+      {
+      }
+
+   std::vector<intptr_t> valuesFor(TR::FlatMultiMap<intptr_t> &map, int32_t key)
+      {
+      std::vector<intptr_t> values;
+      for (TR::FlatMultiMap<intptr_t>::KeyIterator it(map, key); !it.atEnd(); it.next())
+         values.push_back(it.value());
+      return values;
+      }
+
+   TR::RawAllocator _rawAllocator;
+   TR::SystemSegmentProvider _segmentProvider;
+   TR::Region _region;
+   };
+
+TEST_F(FlatMultiMapTest, EqualKeysAreVisitedInInsertionOrder)
+   {
+   TR::FlatMultiMap<intptr_t> map(_region);
+   for (intptr_t i = 0; i < 10; i++)
+      {
+      map.insert(7, i);
+      map.insert(7 + (int32_t)i * 16, 100 + i);
+      }
+
+   std::vector<intptr_t> values = valuesFor(map, 7);
+   ASSERT_EQ(11u, values.size());
+   EXPECT_EQ(0, values[0]);
+   EXPECT_EQ(100, values[1]);
+   for (intptr_t i = 1; i < 10; i++)
+      EXPECT_EQ(i, values[i + 1]);
+   EXPECT_TRUE(valuesFor(map, 8).empty());
+   }
+
+TEST_F(FlatMultiMapTest, RemoveLeavesOtherEntriesReachable)
+   {
+   TR::FlatMultiMap<intptr_t> map(_region, 16);
+   for (intptr_t i = 0; i < 8; i++)
+      map.insert((int32_t)(i % 2), i);
+
+   for (TR::FlatMultiMap<intptr_t>::KeyIterator it(map, 0); !it.atEnd(); it.next())
+      {
+      if (it.value() == 2 || it.value() == 4)
+         it.remove();
+      }
+   EXPECT_EQ(6u, map.size());
+
+   std::vector<intptr_t> evens = valuesFor(map, 0);
+   ASSERT_EQ(2u, evens.size());
+   EXPECT_EQ(0, evens[0]);
+   EXPECT_EQ(6, evens[1]);
+   EXPECT_EQ(4u, valuesFor(map, 1).size());
+
+   intptr_t last = -1;
+   EXPECT_EQ(4u, map.removeAll(1, &last));
+   EXPECT_EQ(7, last);
+   EXPECT_TRUE(valuesFor(map, 1).empty());
+   EXPECT_EQ(0u, map.removeAll(1, &last));
+   EXPECT_EQ(2u, map.size());
+   }
+
+TEST_F(FlatMultiMapTest, EmptyMapAllocatesNothing)
+   {
+   size_t bytes = _region.bytesAllocated();
+   TR::FlatMultiMap<intptr_t> map(_region);
+   EXPECT_TRUE(valuesFor(map, 0).empty());
+   EXPECT_EQ(0u, map.removeAll(42));
+   map.clear();
+   EXPECT_EQ(0u, map.capacity());
+   EXPECT_EQ(bytes, _region.bytesAllocated());
+
+   map.insert(42, 1);
+   EXPECT_LT(0u, map.capacity());
+   EXPECT_EQ(1u, valuesFor(map, 42).size());
+   }
+
+TEST_F(FlatMultiMapTest, ClearDiscardsEveryEntry)
+   {
+   TR::FlatMultiMap<intptr_t> map(_region);
+   uint32_t capacity = 0;
+   for (int32_t round = 0; round < 1000; round++)
+      {
+      EXPECT_TRUE(map.empty());
+      for (int32_t key = 0; key < 20; key++)
+         map.insert(key, round);
+      std::vector<intptr_t> values = valuesFor(map, round % 20);
+      ASSERT_EQ(1u, values.size());
+      EXPECT_EQ(round, values[0]);
+      if (round == 0)
+         capacity = map.capacity();
+      map.clear();
+      }
+   EXPECT_EQ(capacity, map.capacity());
+   }
+
+TEST_F(FlatMultiMapTest, RehashKeepsOrderAndDropsTombstones)
+   {
+   TR::FlatMultiMap<intptr_t> map(_region, 16);
+   for (intptr_t i = 0; i < 1000; i++)
+      {
+      map.insert((int32_t)(i % 3), i);
+      if (i % 5 == 0)
+         map.removeAll(-1);
+      }
+   EXPECT_EQ(1000u, map.size());
+
+   std::vector<intptr_t> values = valuesFor(map, 2);
+   ASSERT_EQ(333u, values.size());
+   for (size_t i = 0; i < values.size(); i++)
+      EXPECT_EQ((intptr_t)(3 * i + 2), values[i]);
+
+   // Churn with removals only reuses the existing table once tombstones are swept
+   map.clear();
+   size_t capacity = map.capacity();
+   for (intptr_t i = 0; i < 100000; i++)
+      {
+      map.insert((int32_t)i, i);
+      map.removeAll((int32_t)i);
+      }
+   EXPECT_EQ(0u, map.size());
+   EXPECT_EQ(capacity, map.capacity());
+   }
+
+/**
+ * Replays the access pattern of local CSE, a few hundred expressions per block with lookups,
+ * kills by symbol reference and a bulk clear at the end of each block, against std::multimap
+ * in a region, which is what the optimization used before.
+ */
+TEST_F(FlatMultiMapTest, LocalCSEWorkload)
+   {
+   const int32_t blocks = 2000;
+   const int32_t nodesPerBlock = 300;
+   const int32_t symRefs = 40;
+
+   typedef TR::typed_allocator<std::pair<const int32_t, intptr_t>, TR::Region &> MultiMapAllocator;
+   typedef std::multimap<int32_t, intptr_t, std::less<int32_t>, MultiMapAllocator> MultiMap;
+
+   intptr_t treeChecksum = 0;
+   size_t treeBytes = 0;
+   clock_t treeStart = clock();
+      {
+      TR::Region region(_segmentProvider, _rawAllocator);
+      MultiMap *map = new (region) MultiMap(std::less<int32_t>(), region);
+      for (int32_t block = 0; block < blocks; block++)
+         {
+         for (int32_t n = 0; n < nodesPerBlock; n++)
+            {
+            int32_t key = (n * 7 + block) % symRefs;
+            std::pair<MultiMap::iterator, MultiMap::iterator> range = map->equal_range(key);
+            if (range.first != range.second)
+               treeChecksum += range.first->second;
+            map->insert(std::make_pair(key, (intptr_t)n));
+            if (n % 16 == 0)
+               {
+               range = map->equal_range((key + 1) % symRefs);
+               map->erase(range.first, range.second);
+               }
+            }
+         map->clear();
+         }
+      treeBytes = region.bytesAllocated();
+      }
+   double treeSeconds = (double)(clock() - treeStart) / CLOCKS_PER_SEC;
+
+   intptr_t flatChecksum = 0;
+   size_t flatBytes = 0;
+   clock_t flatStart = clock();
+      {
+      TR::Region region(_segmentProvider, _rawAllocator);
+      TR::FlatMultiMap<intptr_t> *map = new (region) TR::FlatMultiMap<intptr_t>(region);
+      for (int32_t block = 0; block < blocks; block++)
+         {
+         for (int32_t n = 0; n < nodesPerBlock; n++)
+            {
+            int32_t key = (n * 7 + block) % symRefs;
+            TR::FlatMultiMap<intptr_t>::KeyIterator it(*map, key);
+            if (!it.atEnd())
+               flatChecksum += it.value();
+            map->insert(key, (intptr_t)n);
+            if (n % 16 == 0)
+               map->removeAll((key + 1) % symRefs);
+            }
+         map->clear();
+         }
+      flatBytes = region.bytesAllocated();
+      }
+   double flatSeconds = (double)(clock() - flatStart) / CLOCKS_PER_SEC;
+
+   printf("LocalCSE workload: std::multimap %.3fs %zu region bytes, FlatMultiMap %.3fs %zu region bytes\n",
+      treeSeconds, treeBytes, flatSeconds, flatBytes);
+
+   EXPECT_EQ(treeChecksum, flatChecksum);
+   EXPECT_LT(flatBytes, treeBytes);
+   }
+
+}
@@ -43,8 +43,10 @@
 const char *gcTests[] = {"fvtest/gctest/configuration/sample_GC_config.xml"
                         , "fvtest/gctest/configuration/test_system_gc.xml"
                         , "fvtest/gctest/configuration/global_GC_config.xml"
+                        , "fvtest/gctest/configuration/multithread_GC_config.xml"
 #if defined(OMR_GC_MODRON_CONCURRENT_MARK)
                         , "fvtest/gctest/configuration/optavgpause_GC_config.xml"
+                        , "fvtest/gctest/configuration/multithread_optavgpause_GC_config.xml"
 #endif
 #if defined(OMR_GC_MODRON_SCAVENGER)
                         , "fvtest/gctest/configuration/scavenger_GC_config.xml"
@@ -53,11 +55,20 @@ const char *gcTests[] = {"fvtest/gctest/configuration/sample_GC_config.xml"
 #if defined(OMR_GC_MODRON_SCAVENGER) && defined(OMR_GC_MODRON_CONCURRENT_MARK)
                         , "fvtest/gctest/configuration/gencon_GC_config.xml"
                         , "fvtest/gctest/configuration/gencon_GC_backout_config.xml"
+                        , "fvtest/gctest/configuration/multithread_gencon_GC_config.xml"
 #endif
                         };
 
-const char *perfTests[] = {"perftest/gctest/configuration/21645_core.20150126.202455.11862202.0001.xml",
-								"perftest/gctest/configuration/24404_core.20140723.091737.5812.0002.xml"};
+const char *perfTests[] = {"perftest/gctest/configuration/21645_core.20150126.202455.11862202.0001.xml"
+								, "perftest/gctest/configuration/24404_core.20140723.091737.5812.0002.xml"
+								, "perftest/gctest/configuration/scenario_optthruput.xml"
+#if defined(OMR_GC_MODRON_CONCURRENT_MARK)
+								, "perftest/gctest/configuration/scenario_optavgpause.xml"
+#endif
+#if defined(OMR_GC_MODRON_SCAVENGER) && defined(OMR_GC_MODRON_CONCURRENT_MARK)
+								, "perftest/gctest/configuration/scenario_gencon.xml"
+#endif
+								};
 void
 GCConfigTest::SetUp()
 {
@@ -116,15 +127,7 @@ GCConfigTest::SetUp()
 	verboseManager->enableVerboseGC();
 	verboseManager->setInitializedTime(omrtime_hires_clock());
 
-	/* Initialize root table */
-	exampleVM->rootTable = hashTableNew(
-			exampleVM->_omrVM->_runtime->_portLibrary, OMR_GET_CALLSITE(), 0, sizeof(RootEntry), 0, 0, OMRMEM_CATEGORY_MM,
-			rootTableHashFn, rootTableHashEqualFn, NULL, NULL);
-
-	/* Initialize object table */
-	exampleVM->objectTable = hashTableNew(
-			exampleVM->_omrVM->_runtime->_portLibrary, OMR_GET_CALLSITE(), 0, sizeof(ObjectEntry), 0, 0, OMRMEM_CATEGORY_MM,
-			objectTableHashFn, objectTableHashEqualFn, NULL, NULL);
+	createObjectTables();
 }
 
 void
@@ -132,18 +135,7 @@ GCConfigTest::TearDown()
 {
 	OMRPORT_ACCESS_FROM_OMRPORT(gcTestEnv->portLib);
 
-	/* Free root hash table */
-	if (NULL != exampleVM->rootTable) {
-		hashTableFree(exampleVM->rootTable);
-		exampleVM->rootTable = NULL;
-	}
-
-	/* Free object hash table */
-	if (NULL != exampleVM->objectTable) {
-		hashTableForEachDo(exampleVM->objectTable, objectTableFreeFn, exampleVM);
-		hashTableFree(exampleVM->objectTable);
-		exampleVM->objectTable = NULL;
-	}
+	freeObjectTables();
 
 	/* close verboseManager and clean up verbose files */
 	if (NULL != verboseManager) {
@@ -203,6 +195,37 @@ GCConfigTest::TearDown()
 	printMemUsed("TearDown()", gcTestEnv->portLib);
 }
 
+void
+GCConfigTest::createObjectTables()
+{
+	/* Initialize root table */
+	exampleVM->rootTable = hashTableNew(
+			exampleVM->_omrVM->_runtime->_portLibrary, OMR_GET_CALLSITE(), 0, sizeof(RootEntry), 0, 0, OMRMEM_CATEGORY_MM,
+			rootTableHashFn, rootTableHashEqualFn, NULL, NULL);
+
+	/* Initialize object table */
+	exampleVM->objectTable = hashTableNew(
+			exampleVM->_omrVM->_runtime->_portLibrary, OMR_GET_CALLSITE(), 0, sizeof(ObjectEntry), 0, 0, OMRMEM_CATEGORY_MM,
+			objectTableHashFn, objectTableHashEqualFn, NULL, NULL);
+}
+
+void
+GCConfigTest::freeObjectTables()
+{
+	/* Free root hash table */
+	if (NULL != exampleVM->rootTable) {
+		hashTableFree(exampleVM->rootTable);
+		exampleVM->rootTable = NULL;
+	}
+
+	/* Free object hash table */
+	if (NULL != exampleVM->objectTable) {
+		hashTableForEachDo(exampleVM->objectTable, objectTableFreeFn, exampleVM);
+		hashTableFree(exampleVM->objectTable);
+		exampleVM->objectTable = NULL;
+	}
+}
+
 void
 GCConfigTest::freeAttributeList(AttributeElem *root)
 {
@@ -979,6 +1002,307 @@ done:
 	return rt;
 }
 
+static uint32_t
+mutatorLatencyBucket(uint64_t nanos)
+{
+	uint32_t bucket = 0;
+	while ((1 < nanos) && (bucket < (MUTATOR_LATENCY_BUCKETS - 1))) {
+		nanos >>= 1;
+		bucket += 1;
+	}
+	return bucket;
+}
+
+static int J9THREAD_PROC
+mutatorThreadMain(void *arg)
+{
+	MutatorThread *mutator = (MutatorThread *)arg;
+	OMR_VM_Example *exampleVM = mutator->exampleVM;
+	MutatorBarrier *barrier = mutator->barrier;
+	OMRPORT_ACCESS_FROM_OMRVM(exampleVM->_omrVM);
+
+	OMR_VMThread *omrVMThread = NULL;
+	if (OMR_ERROR_NONE != OMR_Thread_Init(exampleVM->_omrVM, NULL, &omrVMThread, "OMRMutatorThread")) {
+		mutator->rt = 1;
+		omrVMThread = NULL;
+	}
+
+	/* wait until every mutator is attached so that all of them start allocating together */
+	omrthread_monitor_enter(barrier->monitor);
+	barrier->attached += 1;
+	omrthread_monitor_notify_all(barrier->monitor);
+	while (!barrier->started) {
+		omrthread_monitor_wait(barrier->monitor);
+	}
+	omrthread_monitor_exit(barrier->monitor);
+
+	if (NULL != omrVMThread) {
+		MM_EnvironmentBase *env = MM_EnvironmentBase::getEnvironment(omrVMThread);
+		uintptr_t seed = (uintptr_t)mutator->index * 2654435761U + 1;
+		uint64_t startTime = (uint64_t)omrtime_nano_time();
+
+		env->acquireVMAccess();
+		for (uintptr_t i = 0; i < mutator->allocations; i++) {
+			/* pick the next object size from the weighted allocation mix */
+			seed = (seed * 1103515245) + 12345;
+			uint32_t pick = (uint32_t)((seed >> 16) % mutator->totalWeight);
+			MutatorAllocationMix *mix = mutator->mix;
+			while (pick >= mix->weight) {
+				pick -= mix->weight;
+				mix += 1;
+			}
+
+			uint8_t objectAllocationModelSpace[sizeof(MM_ObjectAllocationModel)];
+			MM_ObjectAllocationModel *allocationModel = new(objectAllocationModelSpace)
+					MM_ObjectAllocationModel(env, mix->size, MM_ObjectAllocationModel::selectObjectAllocationFlags(false, false, false, false));
+			uint64_t allocationStart = (uint64_t)omrtime_nano_time();
+			omrobjectptr_t objectPtr = OMR_GC_AllocateObject(omrVMThread, allocationModel);
+			uint64_t latency = (uint64_t)omrtime_nano_time() - allocationStart;
+			if (NULL == objectPtr) {
+				gcTestEnv->log(LEVEL_ERROR, "%s:%d Mutator %u failed to allocate object of size 0x%llx.\n", __FILE__, __LINE__, mutator->index, mix->size);
+				mutator->rt = 1;
+				break;
+			}
+			mutator->latencyHistogram[mutatorLatencyBucket(latency)] += 1;
+			if (latency > mutator->maxLatencyNanos) {
+				mutator->maxLatencyNanos = latency;
+			}
+			mutator->objectsAllocated += 1;
+			mutator->bytesAllocated += env->getExtensions()->objectModel.getConsumedSizeInBytesWithHeader(objectPtr);
+
+			/* keep the object alive until the mutator wraps around its anchor and replaces it */
+			omrobjectptr_t anchor = mutator->anchorEntry->rootPtr;
+			fomrobject_t *slot = (fomrobject_t *)anchor + 1 + (i % mutator->liveObjects);
+			standardWriteBarrierStore(omrVMThread, anchor, slot, objectPtr);
+
+			if (env->isExclusiveAccessRequestWaiting()) {
+				env->releaseVMAccess();
+				while (env->isExclusiveAccessRequestWaiting()) {
+					omrthread_yield();
+				}
+				env->acquireVMAccess();
+			}
+		}
+		env->releaseVMAccess();
+
+		mutator->elapsedNanos = (uint64_t)omrtime_nano_time() - startTime;
+		OMR_Thread_Free(omrVMThread);
+	}
+
+	omrthread_monitor_enter(barrier->monitor);
+	barrier->finished += 1;
+	omrthread_monitor_notify_all(barrier->monitor);
+	omrthread_monitor_exit(barrier->monitor);
+
+	return 0;
+}
+
+int32_t
+GCConfigTest::parseMutatorThreads(pugi::xml_node node, MutatorThread **mutatorsPtr, uint32_t *mutatorCountPtr)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(gcTestEnv->portLib);
+	int32_t rt = 1;
+	uint32_t mutatorCount = 0;
+	MutatorThread *mutators = NULL;
+
+	for (pugi::xml_node threadNode = node.child("thread"); threadNode; threadNode = threadNode.next_sibling("thread")) {
+		mutatorCount += threadNode.attribute("count").as_uint(1);
+	}
+	if (0 == mutatorCount) {
+		gcTestEnv->log(LEVEL_ERROR, "%s:%d Invalid XML input: mutators node requires at least one thread.\n", __FILE__, __LINE__);
+		goto done;
+	}
+
+	mutators = (MutatorThread *)omrmem_allocate_memory(sizeof(MutatorThread) * mutatorCount, OMRMEM_CATEGORY_MM);
+	if (NULL == mutators) {
+		gcTestEnv->log(LEVEL_ERROR, "%s:%d Failed to allocate native memory.\n", __FILE__, __LINE__);
+		goto done;
+	}
+	memset(mutators, 0, sizeof(MutatorThread) * mutatorCount);
+	*mutatorsPtr = mutators;
+	*mutatorCountPtr = mutatorCount;
+
+	{
+		uint32_t index = 0;
+		for (pugi::xml_node threadNode = node.child("thread"); threadNode; threadNode = threadNode.next_sibling("thread")) {
+			uint32_t count = threadNode.attribute("count").as_uint(1);
+			uintptr_t allocations = (uintptr_t)threadNode.attribute("allocations").as_ullong(0);
+			uintptr_t liveObjects = (uintptr_t)threadNode.attribute("liveObjects").as_ullong(64);
+			uint32_t mixCount = 0;
+			uint32_t totalWeight = 0;
+			for (pugi::xml_node mixNode = threadNode.child("mix"); mixNode; mixNode = mixNode.next_sibling("mix")) {
+				mixCount += 1;
+				totalWeight += mixNode.attribute("weight").as_uint(1);
+			}
+			if ((0 == allocations) || (0 == liveObjects) || (0 == totalWeight)) {
+				gcTestEnv->log(LEVEL_ERROR, "%s:%d Invalid XML input: mutator thread requires allocations, liveObjects and at least one weighted mix.\n", __FILE__, __LINE__);
+				goto done;
+			}
+
+			for (uint32_t i = 0; i < count; i++, index++) {
+				MutatorThread *mutator = &mutators[index];
+				mutator->exampleVM = exampleVM;
+				mutator->index = index;
+				mutator->allocations = allocations;
+				mutator->liveObjects = liveObjects;
+				mutator->totalWeight = totalWeight;
+				mutator->mix = (MutatorAllocationMix *)omrmem_allocate_memory(sizeof(MutatorAllocationMix) * mixCount, OMRMEM_CATEGORY_MM);
+				if (NULL == mutator->mix) {
+					gcTestEnv->log(LEVEL_ERROR, "%s:%d Failed to allocate native memory.\n", __FILE__, __LINE__);
+					goto done;
+				}
+				for (pugi::xml_node mixNode = threadNode.child("mix"); mixNode; mixNode = mixNode.next_sibling("mix")) {
+					uintptr_t numOfFields = (uintptr_t)mixNode.attribute(xs.numOfFields).as_ullong(0);
+					MutatorAllocationMix *mix = &mutator->mix[mutator->mixCount];
+					mix->size = numOfFields * sizeof(fomrobject_t) + sizeof(uintptr_t);
+					mix->weight = mixNode.attribute("weight").as_uint(1);
+					mutator->mixCount += 1;
+				}
+			}
+		}
+	}
+	rt = 0;
+
+done:
+	return rt;
+}
+
+int32_t
+GCConfigTest::runMutators(pugi::xml_node node)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(gcTestEnv->portLib);
+	int32_t rt = 1;
+	MutatorThread *mutators = NULL;
+	uint32_t mutatorCount = 0;
+	uint32_t mutatorsCreated = 0;
+	uint64_t startTime = 0;
+	uint64_t elapsedNanos = 0;
+	uintptr_t totalObjects = 0;
+	uintptr_t totalBytes = 0;
+	MutatorBarrier barrier;
+	barrier.monitor = NULL;
+	barrier.attached = 0;
+	barrier.finished = 0;
+	barrier.started = false;
+
+	rt = parseMutatorThreads(node, &mutators, &mutatorCount);
+	OMRGCTEST_CHECK_RT(rt);
+	rt = 1;
+
+	if (0 != omrthread_monitor_init_with_name(&barrier.monitor, 0, "GCConfigTest mutator barrier")) {
+		gcTestEnv->log(LEVEL_ERROR, "%s:%d Failed to initialize mutator barrier.\n", __FILE__, __LINE__);
+		goto done;
+	}
+
+	/* each mutator keeps its live objects in the slots of a rooted anchor object */
+	for (uint32_t i = 0; i < mutatorCount; i++) {
+		uintptr_t anchorSize = mutators[i].liveObjects * sizeof(fomrobject_t) + sizeof(uintptr_t);
+		ObjectEntry *anchorEntry = createObject("MUTATOR", GARBAGE_ROOT, 0, (int32_t)i, anchorSize);
+		if (NULL == anchorEntry) {
+			goto done;
+		}
+		RootEntry rEntry;
+		rEntry.name = anchorEntry->name;
+		rEntry.rootPtr = anchorEntry->objPtr;
+		if (NULL == hashTableAdd(exampleVM->rootTable, &rEntry)) {
+			gcTestEnv->log(LEVEL_ERROR, "%s:%d Failed to add new root entry to root table!\n", __FILE__, __LINE__);
+			goto done;
+		}
+	}
+	/* root entries do not move once the root table stops growing */
+	for (uint32_t i = 0; i < mutatorCount; i++) {
+		char anchorName[MAX_NAME_LENGTH];
+		omrstr_printf(anchorName, MAX_NAME_LENGTH, "%s_%d_%d", "MUTATOR", 0, (int32_t)i);
+		RootEntry searchEntry;
+		searchEntry.name = anchorName;
+		mutators[i].anchorEntry = (RootEntry *)hashTableFind(exampleVM->rootTable, &searchEntry);
+		mutators[i].barrier = &barrier;
+	}
+
+	for (; mutatorsCreated < mutatorCount; mutatorsCreated++) {
+		omrthread_t handle = NULL;
+		if (0 != omrthread_create_ex(&handle, J9THREAD_ATTR_DEFAULT, 0, mutatorThreadMain, &mutators[mutatorsCreated])) {
+			gcTestEnv->log(LEVEL_ERROR, "%s:%d Failed to create mutator thread %u.\n", __FILE__, __LINE__, mutatorsCreated);
+			break;
+		}
+	}
+
+	/* release the mutators together once all of them are attached, then wait for them to finish */
+	omrthread_monitor_enter(barrier.monitor);
+	while (barrier.attached < mutatorsCreated) {
+		omrthread_monitor_wait(barrier.monitor);
+	}
+	startTime = (uint64_t)omrtime_nano_time();
+	barrier.started = true;
+	omrthread_monitor_notify_all(barrier.monitor);
+	while (barrier.finished < mutatorsCreated) {
+		omrthread_monitor_wait(barrier.monitor);
+	}
+	omrthread_monitor_exit(barrier.monitor);
+	elapsedNanos = (uint64_t)omrtime_nano_time() - startTime;
+
+	if (mutatorsCreated < mutatorCount) {
+		goto done;
+	}
+
+	for (uint32_t i = 0; i < mutatorCount; i++) {
+		reportMutator(&mutators[i]);
+		totalObjects += mutators[i].objectsAllocated;
+		totalBytes += mutators[i].bytesAllocated;
+		if (0 != mutators[i].rt) {
+			goto done;
+		}
+	}
+	gcTestEnv->log("%u mutators allocated %zu objects (%zu bytes) in %llu ms\n", mutatorCount, totalObjects, totalBytes, elapsedNanos / 1000000);
+
+	/* drop the anchors so that the mutator objects become garbage */
+	for (uint32_t i = 0; i < mutatorCount; i++) {
+		rt = removeObjectFromRootTable(mutators[i].anchorEntry->name);
+		OMRGCTEST_CHECK_RT(rt);
+	}
+
+done:
+	if (NULL != barrier.monitor) {
+		omrthread_monitor_destroy(barrier.monitor);
+	}
+	if (NULL != mutators) {
+		for (uint32_t i = 0; i < mutatorCount; i++) {
+			omrmem_free_memory(mutators[i].mix);
+		}
+		omrmem_free_memory(mutators);
+	}
+	return rt;
+}
+
+void
+GCConfigTest::reportMutator(MutatorThread *mutator)
+{
+	uint64_t p50 = 0;
+	uint64_t p99 = 0;
+	uint64_t cumulative = 0;
+	uint64_t p50Rank = (mutator->objectsAllocated * 50 + 99) / 100;
+	uint64_t p99Rank = (mutator->objectsAllocated * 99 + 99) / 100;
+
+	for (uint32_t bucket = 0; bucket < MUTATOR_LATENCY_BUCKETS; bucket++) {
+		cumulative += mutator->latencyHistogram[bucket];
+		if ((0 == p50) && (cumulative >= p50Rank)) {
+			p50 = (uint64_t)2 << bucket;
+		}
+		if ((0 == p99) && (cumulative >= p99Rank)) {
+			p99 = (uint64_t)2 << bucket;
+		}
+	}
+
+	gcTestEnv->log("Mutator %u: %zu objects (%zu bytes) in %llu ms; allocation latency p50 < %llu ns, p99 < %llu ns, max %llu ns\n",
+			mutator->index, mutator->objectsAllocated, mutator->bytesAllocated, mutator->elapsedNanos / 1000000, p50, p99, mutator->maxLatencyNanos);
+	for (uint32_t bucket = 0; bucket < MUTATOR_LATENCY_BUCKETS; bucket++) {
+		if (0 != mutator->latencyHistogram[bucket]) {
+			uint64_t lower = (0 == bucket) ? 0 : ((uint64_t)1 << bucket);
+			gcTestEnv->log("\t[%llu, %llu) ns: %llu\n", lower, (uint64_t)2 << bucket, mutator->latencyHistogram[bucket]);
+		}
+	}
+}
+
 int32_t
 GCConfigTest::iniXMLStr(const char *configStyle)
 {
@@ -1031,12 +1355,22 @@ TEST_P(GCConfigTest, test)
 			rt = parseGarbagePolicy(configChild.child(xs.garbagePolicy));
 			ASSERT_EQ(0, rt) << "Failed to parse garbage policy.";
 			pugi::xpath_node_set objects = configChild.select_nodes(xs.object);
+			/* scaled workloads repeat the allocation; each pass drops the object graph built by the previous one */
+			uint32_t iterations = configChild.attribute("iterations").as_uint(1);
 			int64_t startTime = omrtime_current_time_millis();
-			for (pugi::xpath_node_set::const_iterator it = objects.begin(); it != objects.end(); ++it) {
-				rt = allocationWalker(it->node());
-				ASSERT_EQ(0, rt) << "Failed to perform allocation.";
+			for (uint32_t iteration = 0; iteration < iterations; iteration++) {
+				if (0 < iteration) {
+					freeObjectTables();
+					createObjectTables();
+					gp.garbageSeq = 0;
+					gp.accumulatedSize = 0;
+				}
+				for (pugi::xpath_node_set::const_iterator it = objects.begin(); it != objects.end(); ++it) {
+					rt = allocationWalker(it->node());
+					ASSERT_EQ(0, rt) << "Failed to perform allocation.";
+				}
 			}
-			gcTestEnv->log("Time elapsed in allocation: %lld ms\n", (omrtime_current_time_millis() - startTime));
+			gcTestEnv->log("Time elapsed in allocation: %lld ms (%u iterations)\n", (omrtime_current_time_millis() - startTime), iterations);
 		} else if (0 == strcmp(configChild.name(), "verification")) {
 			gcTestEnv->log("\n++++++++++++++++++++++++++Verification++++++++++++++++++++++++++\n");
 			/* verboseGC verification */
@@ -1051,6 +1385,10 @@ TEST_P(GCConfigTest, test)
 			gcTestEnv->log("\n++++++++++++++++++++++++++++Operation+++++++++++++++++++++++++++\n");
 			rt = triggerOperation(configChild.first_child());
 			ASSERT_EQ(0, rt) << "Failed to perform gc operation.";
+		} else if (0 == strcmp(configChild.name(), "mutators")) {
+			gcTestEnv->log("\n++++++++++++++++++++++++++++Mutators++++++++++++++++++++++++++++\n");
+			rt = runMutators(configChild);
+			ASSERT_EQ(0, rt) << "Failed to run mutator threads.";
 		} else if (0 == strcmp(configChild.name(), "mutation")) {
 			/*TODO*/
 		} else {
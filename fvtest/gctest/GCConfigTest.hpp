@@ -56,6 +56,38 @@ typedef struct GarbagePolicy {
 	uintptr_t accumulatedSize;
 } GarbagePolicy;
 
+#define MUTATOR_LATENCY_BUCKETS 32
+
+typedef struct MutatorAllocationMix {
+	uintptr_t size;
+	uint32_t weight;
+} MutatorAllocationMix;
+
+typedef struct MutatorBarrier {
+	omrthread_monitor_t monitor;
+	uint32_t attached;
+	uint32_t finished;
+	bool started;
+} MutatorBarrier;
+
+typedef struct MutatorThread {
+	OMR_VM_Example *exampleVM;
+	MutatorBarrier *barrier;
+	RootEntry *anchorEntry;
+	uint32_t index;
+	uintptr_t allocations;
+	uintptr_t liveObjects;
+	MutatorAllocationMix *mix;
+	uint32_t mixCount;
+	uint32_t totalWeight;
+	int32_t rt;
+	uintptr_t objectsAllocated;
+	uintptr_t bytesAllocated;
+	uint64_t elapsedNanos;
+	uint64_t maxLatencyNanos;
+	uint64_t latencyHistogram[MUTATOR_LATENCY_BUCKETS]; /* bucket i counts allocations taking [2^i, 2^(i+1)) ns */
+} MutatorThread;
+
 typedef struct XmlStr {
 	const char *object;
 	const char *namePrefix;
@@ -91,6 +123,8 @@ protected:
 	 * Function members
 	 */
 protected:
+	void createObjectTables();
+	void freeObjectTables();
 	void freeAttributeList(AttributeElem *root);
 	int32_t parseAttribute(AttributeElem **root, const char *attrStr);
 	OMRGCObjectType parseObjectType(pugi::xml_node node);
@@ -110,6 +144,9 @@ protected:
 	int32_t verifyVerboseGC(pugi::xpath_node_set verboseGCs);
 	int32_t parseGarbagePolicy(pugi::xml_node node);
 	int32_t triggerOperation(pugi::xml_node node);
+	int32_t parseMutatorThreads(pugi::xml_node node, MutatorThread **mutatorsPtr, uint32_t *mutatorCountPtr);
+	int32_t runMutators(pugi::xml_node node);
+	void reportMutator(MutatorThread *mutator);
 	int32_t iniXMLStr(const char *configStyle);
 
 	/* This implementation assumes that existing entries hashed into the rootTable and objectTable can
@@ -37,7 +37,7 @@ MM_StartupManagerTestExample::parseLanguageOptions(MM_GCExtensionsBase *extensio
 		/* parse options */
 		pugi::xpath_node option = doc.select_node("/gc-config/option");
 
-		int32_t unitSize = 1;
+		uintptr_t unitSize = 1;
 		const char *unit = option.node().attribute("sizeUnit").value();
 		if (0 != strcmp(unit, "")) {
 			if (0 == j9_cmdla_stricmp(unit, "B")) {
@@ -57,31 +57,31 @@ MM_StartupManagerTestExample::parseLanguageOptions(MM_GCExtensionsBase *extensio
 		if (result) {
 			for (pugi::xml_attribute attr = option.node().first_attribute(); attr; attr = attr.next_attribute()) {
 				if (0 == strcmp(attr.name(), "memoryMax")) {
-					extensions->memoryMax = atoi(attr.value()) * unitSize;
+					extensions->memoryMax = (uintptr_t)atoi(attr.value()) * unitSize;
 				} else if (0 == strcmp(attr.name(), "initialMemorySize")) {
-					extensions->initialMemorySize = atoi(attr.value()) * unitSize;
+					extensions->initialMemorySize = (uintptr_t)atoi(attr.value()) * unitSize;
 				} else if (0 == strcmp(attr.name(), "minNewSpaceSize")) {
-					extensions->minNewSpaceSize = atoi(attr.value()) * unitSize;
+					extensions->minNewSpaceSize = (uintptr_t)atoi(attr.value()) * unitSize;
 				} else if (0 == strcmp(attr.name(), "newSpaceSize")) {
-					extensions->newSpaceSize = atoi(attr.value()) * unitSize;
+					extensions->newSpaceSize = (uintptr_t)atoi(attr.value()) * unitSize;
 				} else if (0 == strcmp(attr.name(), "maxNewSpaceSize")) {
-					extensions->maxNewSpaceSize = atoi(attr.value()) * unitSize;
+					extensions->maxNewSpaceSize = (uintptr_t)atoi(attr.value()) * unitSize;
 				} else if (0 == strcmp(attr.name(), "minOldSpaceSize")) {
-					extensions->minOldSpaceSize = atoi(attr.value()) * unitSize;
+					extensions->minOldSpaceSize = (uintptr_t)atoi(attr.value()) * unitSize;
 				} else if (0 == strcmp(attr.name(), "oldSpaceSize")) {
-					extensions->oldSpaceSize = atoi(attr.value()) * unitSize;
+					extensions->oldSpaceSize = (uintptr_t)atoi(attr.value()) * unitSize;
 				} else if (0 == strcmp(attr.name(), "maxOldSpaceSize")) {
-					extensions->maxOldSpaceSize = atoi(attr.value()) * unitSize;
+					extensions->maxOldSpaceSize = (uintptr_t)atoi(attr.value()) * unitSize;
 				} else if (0 == strcmp(attr.name(), "allocationIncrement")) {
-					extensions->allocationIncrement = atoi(attr.value()) * unitSize;
+					extensions->allocationIncrement = (uintptr_t)atoi(attr.value()) * unitSize;
 				} else if (0 == strcmp(attr.name(), "fixedAllocationIncrement")) {
-					extensions->fixedAllocationIncrement = atoi(attr.value()) * unitSize;
+					extensions->fixedAllocationIncrement = (uintptr_t)atoi(attr.value()) * unitSize;
 				} else if (0 == strcmp(attr.name(), "lowMinimum")) {
-					extensions->lowMinimum = atoi(attr.value()) * unitSize;
+					extensions->lowMinimum = (uintptr_t)atoi(attr.value()) * unitSize;
 				} else if (0 == strcmp(attr.name(), "allowMergedSpaces")) {
-					extensions->allowMergedSpaces = atoi(attr.value()) * unitSize;
+					extensions->allowMergedSpaces = (uintptr_t)atoi(attr.value()) * unitSize;
 				} else if (0 == strcmp(attr.name(), "maxSizeDefaultMemorySpace")) {
-					extensions->maxSizeDefaultMemorySpace = atoi(attr.value()) * unitSize;
+					extensions->maxSizeDefaultMemorySpace = (uintptr_t)atoi(attr.value()) * unitSize;
 				} else if (0 == strcmp(attr.name(), "gcthreadCount")) {
 					/* TODO: support multi-thread GC*/
 				} else if (0 == strcmp(attr.name(), "GCPolicy")) {
@@ -91,8 +91,8 @@ MM_StartupManagerTestExample::parseLanguageOptions(MM_GCExtensionsBase *extensio
 #else
 						gcTestEnv->log(LEVEL_ERROR, "WARNING: GCPolicy=gencon ignored, requires OMR_GC_MODRON_SCAVENGER (see configure_common.mk)\n");
 #endif /* defined(OMR_GC_MODRON_SCAVENGER) */
-					} else  if (0 != j9_cmdla_stricmp(attr.value(), "optavgpause")) {
-						gcTestEnv->log(LEVEL_ERROR, "Failed: Unrecognized GC policy (expected gencon or optavgpause): %s\n", attr.value());
+					} else if ((0 != j9_cmdla_stricmp(attr.value(), "optavgpause")) && (0 != j9_cmdla_stricmp(attr.value(), "optthruput"))) {
+						gcTestEnv->log(LEVEL_ERROR, "Failed: Unrecognized GC policy (expected gencon, optavgpause or optthruput): %s\n", attr.value());
 						result = false;
 					}
 				} else if (0 == strcmp(attr.name(), "concurrentMark")) {
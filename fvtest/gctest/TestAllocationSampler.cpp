@@ -0,0 +1,158 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include "omrcfg.h"
+
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+
+#include "mmomrhook.h"
+#include "omrExampleVM.hpp"
+#include "omrgc.h"
+
+#include "AllocationSampler.hpp"
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+#include "ObjectAllocationModel.hpp"
+#include "StartupManagerImpl.hpp"
+#include "gcTestHelpers.hpp"
+
+#include <gtest/gtest.h>
+
+class TestAllocationSampler : public ::testing::Test
+{
+protected:
+	static const uintptr_t SAMPLING_INTERVAL = 16 * 1024;
+
+	OMR_VM_Example *exampleVM;
+	MM_EnvironmentBase *env;
+	MM_GCExtensionsBase *extensions;
+	uintptr_t hookedSamples;
+	uintptr_t hookedBytes;
+	uintptr_t hookedFrames;
+
+	virtual void SetUp();
+	virtual void TearDown();
+
+	static void sampleHook(J9HookInterface **hook, uintptr_t eventNum, void *eventData, void *userData);
+	void allocateObjects(uintptr_t count, uintptr_t size);
+};
+
+const uintptr_t TestAllocationSampler::SAMPLING_INTERVAL;
+
+void
+TestAllocationSampler::SetUp()
+{
+	exampleVM = &gcTestEnv->exampleVM;
+	hookedSamples = 0;
+	hookedBytes = 0;
+	hookedFrames = 0;
+
+	MM_StartupManagerImpl startupManager(exampleVM->_omrVM);
+	ASSERT_EQ(OMR_ERROR_NONE, OMR_GC_IntializeHeapAndCollector(exampleVM->_omrVM, &startupManager));
+	ASSERT_EQ(OMR_ERROR_NONE, OMR_Thread_Init(exampleVM->_omrVM, NULL, &exampleVM->_omrVMThread, "OMRTestThread"));
+	ASSERT_EQ(OMR_ERROR_NONE, OMR_GC_InitializeDispatcherThreads(exampleVM->_omrVMThread));
+
+	env = MM_EnvironmentBase::getEnvironment(exampleVM->_omrVMThread);
+	extensions = env->getExtensions();
+
+	/* equivalent to -Xgc:allocationSamplingInterval=16k */
+	extensions->allocationSamplingBytesGranularity = SAMPLING_INTERVAL;
+	extensions->allocationSampler = MM_AllocationSampler::newInstance(env, extensions->allocationSamplingTopSiteCount);
+	ASSERT_TRUE(NULL != extensions->allocationSampler);
+
+	J9HookInterface **hookInterface = extensions->getOmrHookInterface();
+	ASSERT_EQ(0, (*hookInterface)->J9HookRegisterWithCallSite(hookInterface, J9HOOK_MM_OMR_ALLOCATION_SAMPLE, sampleHook, OMR_GET_CALLSITE(), this));
+}
+
+void
+TestAllocationSampler::TearDown()
+{
+	J9HookInterface **hookInterface = extensions->getOmrHookInterface();
+	(*hookInterface)->J9HookUnregister(hookInterface, J9HOOK_MM_OMR_ALLOCATION_SAMPLE, sampleHook, this);
+
+	/* the configuration kills the sampler on shutdown */
+	ASSERT_EQ(OMR_ERROR_NONE, OMR_GC_ShutdownDispatcherThreads(exampleVM->_omrVMThread));
+	ASSERT_EQ(OMR_ERROR_NONE, OMR_Thread_Free(exampleVM->_omrVMThread));
+	exampleVM->_omrVMThread = NULL;
+	ASSERT_EQ(OMR_ERROR_NONE, OMR_GC_ShutdownHeapAndCollector(exampleVM->_omrVM));
+}
+
+void
+TestAllocationSampler::sampleHook(J9HookInterface **hook, uintptr_t eventNum, void *eventData, void *userData)
+{
+	MM_AllocationSampleEvent *event = (MM_AllocationSampleEvent *)eventData;
+	TestAllocationSampler *test = (TestAllocationSampler *)userData;
+
+	EXPECT_TRUE(NULL != event->object);
+	EXPECT_LE(TestAllocationSampler::SAMPLING_INTERVAL, event->sampledBytes);
+	EXPECT_GE(MM_AllocationSampler::MAX_FRAMES, event->frameCount);
+	test->hookedSamples += 1;
+	test->hookedBytes += event->sampledBytes;
+	test->hookedFrames += event->frameCount;
+}
+
+void
+TestAllocationSampler::allocateObjects(uintptr_t count, uintptr_t size)
+{
+	for (uintptr_t i = 0; i < count; i++) {
+		uint8_t objectAllocationModelSpace[sizeof(MM_ObjectAllocationModel)];
+		MM_ObjectAllocationModel *allocationModel = new(objectAllocationModelSpace)
+				MM_ObjectAllocationModel(env, size, MM_ObjectAllocationModel::selectObjectAllocationFlags(false, false, false, true));
+		ASSERT_TRUE(NULL != OMR_GC_AllocateObject(exampleVM->_omrVMThread, allocationModel));
+	}
+}
+
+TEST_F(TestAllocationSampler, SampleAndRankSites)
+{
+	/* stay well within the initial heap, no collection is needed */
+	allocateObjects(192, 1024);
+	allocateObjects(64, 1024);
+
+	MM_AllocationSampler *sampler = extensions->allocationSampler;
+	ASSERT_LT(0, hookedSamples);
+	EXPECT_EQ(hookedSamples, sampler->getSampleCount());
+#if defined(LINUX)
+	EXPECT_LT(0, hookedFrames);
+#endif /* defined(LINUX) */
+
+	MM_AllocationSampler::AllocationSite sites[4];
+	uintptr_t siteCount = sampler->getTopSites(env, sites, 4);
+	ASSERT_LT(0, siteCount);
+	uintptr_t siteBytes = 0;
+	for (uintptr_t i = 0; i < siteCount; i++) {
+		EXPECT_NE(0, sites[i]._key);
+		if (i > 0) {
+			EXPECT_GE(sites[i - 1]._bytes, sites[i]._bytes);
+		}
+		siteBytes += sites[i]._bytes;
+	}
+	/* with fewer sites than table entries the space-saving counts are exact */
+	EXPECT_GE(hookedBytes, siteBytes);
+#if defined(LINUX)
+	EXPECT_LT(0, sites[0]._frameCount);
+#endif /* defined(LINUX) */
+
+	sampler->reset(env);
+	EXPECT_EQ(0, sampler->getTopSites(env, sites, 4));
+}
+
+#endif /* defined(OMR_GC_THREAD_LOCAL_HEAP) */
@@ -0,0 +1,198 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "omrcfg.h"
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+
+#include "omrExampleVM.hpp"
+#include "omrgc.h"
+#include "omrport.h"
+
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+#include "NurseryRegionMap.hpp"
+#include "StartupManagerImpl.hpp"
+#include "gcTestHelpers.hpp"
+
+#include <gtest/gtest.h>
+
+class TestNurseryRegionMap : public ::testing::Test
+{
+protected:
+	static const uintptr_t REGION_SHIFT = 16;
+	static const uintptr_t REGION_SIZE = (uintptr_t)1 << REGION_SHIFT;
+	static const uintptr_t REGION_COUNT = 256;
+	static const uintptr_t HEAP_BASE = 64 * REGION_SIZE;
+
+	OMR_VM_Example *exampleVM;
+	MM_EnvironmentBase *env;
+	MM_NurseryRegionMap *map;
+
+	virtual void SetUp();
+	virtual void TearDown();
+
+	static void *address(uintptr_t region, uintptr_t offset = 0) { return (void *)(HEAP_BASE + (region * REGION_SIZE) + offset); }
+};
+
+const uintptr_t TestNurseryRegionMap::REGION_SHIFT;
+const uintptr_t TestNurseryRegionMap::REGION_SIZE;
+const uintptr_t TestNurseryRegionMap::REGION_COUNT;
+const uintptr_t TestNurseryRegionMap::HEAP_BASE;
+
+void
+TestNurseryRegionMap::SetUp()
+{
+	exampleVM = &gcTestEnv->exampleVM;
+	map = NULL;
+
+	MM_StartupManagerImpl startupManager(exampleVM->_omrVM);
+	ASSERT_EQ(OMR_ERROR_NONE, OMR_GC_IntializeHeapAndCollector(exampleVM->_omrVM, &startupManager));
+	ASSERT_EQ(OMR_ERROR_NONE, OMR_Thread_Init(exampleVM->_omrVM, NULL, &exampleVM->_omrVMThread, "OMRTestThread"));
+	env = MM_EnvironmentBase::getEnvironment(exampleVM->_omrVMThread);
+
+	/* the map only does address arithmetic, so it can describe a heap that is not mapped */
+	map = MM_NurseryRegionMap::newInstance(env, address(0), address(REGION_COUNT), REGION_SHIFT);
+	ASSERT_TRUE(NULL != map);
+}
+
+void
+TestNurseryRegionMap::TearDown()
+{
+	if (NULL != map) {
+		map->kill(env);
+	}
+	ASSERT_EQ(OMR_ERROR_NONE, OMR_Thread_Free(exampleVM->_omrVMThread));
+	exampleVM->_omrVMThread = NULL;
+	ASSERT_EQ(OMR_ERROR_NONE, OMR_GC_ShutdownHeapAndCollector(exampleVM->_omrVM));
+}
+
+TEST_F(TestNurseryRegionMap, SetAndClearRanges)
+{
+	EXPECT_FALSE(map->isInNursery(NULL));
+	EXPECT_FALSE(map->isInNursery(address(0)));
+
+	/* a split nursery: regions [10, 20) and [200, 230) */
+	map->setRange(address(10), address(20), true);
+	map->setRange(address(200), address(230), true);
+
+	EXPECT_FALSE(map->isInNursery(address(9, REGION_SIZE - 1)));
+	EXPECT_TRUE(map->isInNursery(address(10)));
+	EXPECT_TRUE(map->isInNursery(address(19, REGION_SIZE - 1)));
+	EXPECT_FALSE(map->isInNursery(address(20)));
+	EXPECT_FALSE(map->isInNursery(address(100)));
+	EXPECT_TRUE(map->isInNursery(address(200)));
+	EXPECT_TRUE(map->isInNursery(address(229, 8)));
+	EXPECT_FALSE(map->isInNursery(address(230)));
+
+	/* addresses outside the heap are never in the nursery */
+	EXPECT_FALSE(map->isInNursery((void *)(HEAP_BASE - 8)));
+	EXPECT_FALSE(map->isInNursery(address(REGION_COUNT)));
+	EXPECT_FALSE(map->isInNursery(NULL));
+
+	/* partial regions are widened to whole regions */
+	map->setRange(address(40, 8), address(41, 8), true);
+	EXPECT_TRUE(map->isInNursery(address(40)));
+	EXPECT_TRUE(map->isInNursery(address(41, REGION_SIZE - 8)));
+	EXPECT_FALSE(map->isInNursery(address(42)));
+
+	/* contraction of the high part */
+	map->setRange(address(220), address(230), false);
+	EXPECT_TRUE(map->isInNursery(address(219)));
+	EXPECT_FALSE(map->isInNursery(address(220)));
+
+	/* ranges reaching outside the heap are clipped */
+	map->setRange((void *)(HEAP_BASE - REGION_SIZE), address(1), true);
+	EXPECT_TRUE(map->isInNursery(address(0)));
+	EXPECT_FALSE(map->isInNursery(address(1)));
+
+	map->clear();
+	EXPECT_FALSE(map->isInNursery(address(10)));
+	EXPECT_FALSE(map->isInNursery(address(200)));
+}
+
+/**
+ * Microbenchmark of the generational barrier "is the child in the nursery" check with the nursery
+ * split into several parts (as with one nursery part per NUMA node): a range comparison against each
+ * part versus a single region bit test. Reports the cost of both; they must agree.
+ */
+TEST_F(TestNurseryRegionMap, BarrierFastPathSplitNursery)
+{
+	OMRPORT_ACCESS_FROM_OMRVM(exampleVM->_omrVM);
+	const uintptr_t nurseryPartCount = 8;
+	const uintptr_t checkCount = 1 << 16;
+	const uintptr_t repeatCount = 64;
+
+	/* each part is 8 regions followed by 24 regions of tenure space */
+	uintptr_t partBase[nurseryPartCount];
+	uintptr_t partSize = 8 * REGION_SIZE;
+	for (uintptr_t part = 0; part < nurseryPartCount; part++) {
+		partBase[part] = (uintptr_t)address(part * (REGION_COUNT / nurseryPartCount));
+		map->setRange((void *)partBase[part], (void *)(partBase[part] + partSize), true);
+	}
+
+	void **children = (void **)omrmem_allocate_memory(checkCount * sizeof(void *), OMRMEM_CATEGORY_MM);
+	ASSERT_TRUE(NULL != children);
+	uintptr_t seed = 0x2545F491;
+	for (uintptr_t i = 0; i < checkCount; i++) {
+		seed = (seed * 1103515245) + 12345;
+		/* one child in eight is NULL, the rest are spread over the whole heap */
+		children[i] = (0 == (i % 8)) ? NULL : address(0, (seed >> 4) % (REGION_COUNT * REGION_SIZE));
+	}
+
+	uintptr_t rangeHits = 0;
+	uint64_t rangeStart = omrtime_hires_clock();
+	for (uintptr_t repeat = 0; repeat < repeatCount; repeat++) {
+		for (uintptr_t i = 0; i < checkCount; i++) {
+			uintptr_t child = (uintptr_t)children[i];
+			for (uintptr_t part = 0; part < nurseryPartCount; part++) {
+				if ((child - partBase[part]) < partSize) {
+					rangeHits += 1;
+					break;
+				}
+			}
+		}
+	}
+	uint64_t rangeTicks = omrtime_hires_clock() - rangeStart;
+
+	uintptr_t mapHits = 0;
+	uint64_t mapStart = omrtime_hires_clock();
+	for (uintptr_t repeat = 0; repeat < repeatCount; repeat++) {
+		for (uintptr_t i = 0; i < checkCount; i++) {
+			if (map->isInNursery(children[i])) {
+				mapHits += 1;
+			}
+		}
+	}
+	uint64_t mapTicks = omrtime_hires_clock() - mapStart;
+
+	EXPECT_EQ(rangeHits, mapHits);
+	EXPECT_LT((uintptr_t)0, mapHits);
+
+	omrtty_printf("nursery check, %zu nursery parts, %zu checks: range compares %llu us, region map %llu us\n",
+			nurseryPartCount, checkCount * repeatCount,
+			omrtime_hires_delta(0, rangeTicks, OMRPORT_TIME_DELTA_IN_MICROSECONDS),
+			omrtime_hires_delta(0, mapTicks, OMRPORT_TIME_DELTA_IN_MICROSECONDS));
+
+	omrmem_free_memory(children);
+}
+
+#endif /* defined(OMR_GC_MODRON_SCAVENGER) */
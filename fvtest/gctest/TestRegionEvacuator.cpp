@@ -0,0 +1,361 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include "omrcfg.h"
+
+#if defined(OMR_GC_VLHGC)
+
+#include "AllocateDescription.hpp"
+#include "Dispatcher.hpp"
+#include "EnvironmentBase.hpp"
+#include "ForwardedHeader.hpp"
+#include "GCExtensionsBase.hpp"
+#include "Heap.hpp"
+#include "HeapVirtualMemory.hpp"
+#include "HeapLinkedFreeHeader.hpp"
+#include "HeapRegionDescriptor.hpp"
+#include "HeapRegionManagerTarok.hpp"
+#include "MarkMap.hpp"
+#include "MarkingScheme.hpp"
+#include "MemoryHandle.hpp"
+#include "MemoryManager.hpp"
+#include "MemoryPool.hpp"
+#include "MemorySpace.hpp"
+#include "MemorySubSpace.hpp"
+#include "Object.hpp"
+#include "ParallelGlobalGC.hpp"
+#include "RegionEvacuationTask.hpp"
+#include "RegionEvacuator.hpp"
+#include "SlotObject.hpp"
+#include "gcTestHelpers.hpp"
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <vector>
+
+TEST(TestRegionEvacuator, SelectMostGarbageDense)
+{
+    MM_HeapRegionDescriptor *regions[5];
+    for (uintptr_t i = 0; i < 5; i++) {
+        regions[i] = (MM_HeapRegionDescriptor *)(0x1000 + (i * 0x100));
+    }
+    MM_RegionEvacuator::Candidate candidates[5] = {
+        { regions[0], 700, false },
+        { regions[1], 100, false },
+        { regions[2], 900, false },
+        { regions[3], 0, false },
+        { regions[4], 300, false },
+    };
+
+    uintptr_t selected = MM_RegionEvacuator::selectMostGarbageDense(candidates, 5, 3, 800);
+    EXPECT_EQ(selected, 3);
+    EXPECT_EQ(candidates[0]._region, regions[3]);
+    EXPECT_EQ(candidates[1]._region, regions[1]);
+    EXPECT_EQ(candidates[2]._region, regions[4]);
+
+    /* the live bytes threshold wins over the region budget */
+    selected = MM_RegionEvacuator::selectMostGarbageDense(candidates, 5, 5, 300);
+    EXPECT_EQ(selected, 3);
+
+    /* only empty regions qualify, then none */
+    selected = MM_RegionEvacuator::selectMostGarbageDense(candidates, 5, 5, 0);
+    EXPECT_EQ(selected, 1);
+    selected = MM_RegionEvacuator::selectMostGarbageDense(&candidates[1], 4, 5, 50);
+    EXPECT_EQ(selected, 0);
+}
+
+/**
+ * Lays a Tarok region table over the heap of a flat configuration and evacuates two regions
+ * of hand-made objects, copying into memory allocated from the heap's memory pool.
+ */
+class TestRegionEvacuatorHeap : public ::testing::Test
+{
+protected:
+    static const uintptr_t REGION_SIZE = 64 * 1024;
+    static const uintptr_t OBJECT_SIZE = 256;
+    static const uintptr_t OBJECTS_PER_REGION = REGION_SIZE / OBJECT_SIZE;
+
+    OMR_VM_Example *exampleVM;
+    MM_EnvironmentBase *env;
+    MM_GCExtensionsBase *extensions;
+    MM_MemorySubSpace *subSpace;
+    MM_MarkMap *markMap;
+    MM_HeapRegionManagerTarok *regionManager;
+    MM_RegionEvacuator *evacuator;
+    MM_HeapRegionDescriptor *sourceRegions[2];
+    std::vector<Object *> liveObjects[2];
+
+    virtual void SetUp();
+    virtual void TearDown();
+
+    void populateRegion(uintptr_t index, uintptr_t liveStride);
+    void exhaustMemoryPool(uintptr_t bytesToLeave);
+    void evacuate();
+    void verifyCopy(Object *original);
+};
+
+const uintptr_t TestRegionEvacuatorHeap::REGION_SIZE;
+const uintptr_t TestRegionEvacuatorHeap::OBJECT_SIZE;
+const uintptr_t TestRegionEvacuatorHeap::OBJECTS_PER_REGION;
+
+void
+TestRegionEvacuatorHeap::SetUp()
+{
+    exampleVM = &gcTestEnv->exampleVM;
+    env = NULL;
+    regionManager = NULL;
+    evacuator = NULL;
+
+    MM_StartupManagerImpl startupManager(exampleVM->_omrVM);
+    ASSERT_EQ(OMR_ERROR_NONE, OMR_GC_IntializeHeapAndCollector(exampleVM->_omrVM, &startupManager));
+    ASSERT_EQ(OMR_ERROR_NONE, OMR_Thread_Init(exampleVM->_omrVM, NULL, &exampleVM->_omrVMThread, "OMRTestThread"));
+    ASSERT_EQ(OMR_ERROR_NONE, OMR_GC_InitializeDispatcherThreads(exampleVM->_omrVMThread));
+
+    env = MM_EnvironmentBase::getEnvironment(exampleVM->_omrVMThread);
+    extensions = env->getExtensions();
+    markMap = ((MM_ParallelGlobalGC *)extensions->getGlobalCollector())->getMarkingScheme()->getMarkMap();
+
+    /* the leaf subspace owns the memory pool */
+    subSpace = extensions->heap->getDefaultMemorySpace()->getDefaultMemorySubSpace();
+    while (NULL != subSpace->getChildren()) {
+        subSpace = subSpace->getChildren();
+    }
+
+    MM_MemoryHandle *handle = (MM_MemoryHandle *)((MM_HeapVirtualMemory *)extensions->heap)->getVmemHandle();
+    void *heapBase = extensions->memoryManager->getHeapBase(handle);
+    void *heapTop = extensions->memoryManager->getHeapTop(handle);
+    ASSERT_EQ(0, (uintptr_t)heapBase % REGION_SIZE);
+    ASSERT_EQ(0, (uintptr_t)heapTop % REGION_SIZE);
+
+    regionManager = MM_HeapRegionManagerTarok::newInstance(env, REGION_SIZE, sizeof(MM_HeapRegionDescriptor), MM_HeapRegionDescriptor::initializer, MM_HeapRegionDescriptor::destructor);
+    ASSERT_TRUE(NULL != regionManager);
+    ASSERT_TRUE(regionManager->setContiguousHeapRange(env, heapBase, heapTop));
+    ASSERT_TRUE(regionManager->enableRegionsInTable(env, handle));
+    while (NULL != regionManager->acquireSingleTableRegion(env, subSpace, 0)) {
+        /* the whole table is in use; only the source regions are typed as containing objects */
+    }
+
+    evacuator = MM_RegionEvacuator::newInstance(env, regionManager);
+    ASSERT_TRUE(NULL != evacuator);
+
+    /* reserve two aligned regions worth of memory from the pool to build the source objects in */
+    MM_AllocateDescription allocDescription(3 * REGION_SIZE, 0, false, true);
+    void *chunk = subSpace->collectorAllocate(env, extensions->getGlobalCollector(), &allocDescription);
+    ASSERT_TRUE(NULL != chunk);
+    uintptr_t sourceBase = ((uintptr_t)chunk + REGION_SIZE - 1) & ~(REGION_SIZE - 1);
+    for (uintptr_t i = 0; i < 2; i++) {
+        sourceRegions[i] = regionManager->tableDescriptorForAddress((void *)(sourceBase + (i * REGION_SIZE)));
+        sourceRegions[i]->setRegionType(MM_HeapRegionDescriptor::ADDRESS_ORDERED);
+    }
+    markMap->setBitsInRange(env, chunk, (void *)((uintptr_t)chunk + (3 * REGION_SIZE)), true);
+}
+
+void
+TestRegionEvacuatorHeap::TearDown()
+{
+    if (NULL != evacuator) {
+        evacuator->kill(env);
+    }
+    if (NULL != regionManager) {
+        MM_HeapRegionDescriptor *region = NULL;
+        while (NULL != (region = regionManager->getFirstTableRegion())) {
+            regionManager->releaseTableRegions(env, region);
+        }
+        regionManager->destroyRegionTable(env);
+        regionManager->kill(env);
+    }
+    if (NULL != exampleVM->_omrVMThread) {
+        ASSERT_EQ(OMR_ERROR_NONE, OMR_GC_ShutdownDispatcherThreads(exampleVM->_omrVMThread));
+        ASSERT_EQ(OMR_ERROR_NONE, OMR_Thread_Free(exampleVM->_omrVMThread));
+        exampleVM->_omrVMThread = NULL;
+    }
+    ASSERT_EQ(OMR_ERROR_NONE, OMR_GC_ShutdownHeapAndCollector(exampleVM->_omrVM));
+}
+
+/**
+ * Fill a source region with objects, every liveStride'th of which is marked. The first slot of every
+ * fourth object refers to the object at the same position in the other source region, which is live
+ * for all strides used by the tests.
+ */
+void
+TestRegionEvacuatorHeap::populateRegion(uintptr_t index, uintptr_t liveStride)
+{
+    uintptr_t base = (uintptr_t)sourceRegions[index]->getLowAddress();
+    uintptr_t otherBase = (uintptr_t)sourceRegions[1 - index]->getLowAddress();
+    for (uintptr_t i = 0; i < OBJECTS_PER_REGION; i++) {
+        Object *object = new((void *)(base + (i * OBJECT_SIZE))) Object(OBJECT_SIZE);
+        for (Slot *slot = object->begin(); slot < object->end(); slot++) {
+            *slot = (Slot)0;
+        }
+        object->begin()[1] = (Slot)i;
+        if (0 == (i % 4)) {
+            GC_SlotObject slotObject(exampleVM->_omrVM, object->begin());
+            slotObject.writeReferenceToSlot((omrobjectptr_t)(otherBase + (i * OBJECT_SIZE)));
+        }
+        if (0 == (i % liveStride)) {
+            markMap->setBit((omrobjectptr_t)object);
+            liveObjects[index].push_back(object);
+        }
+    }
+}
+
+/**
+ * Allocate every free chunk of the memory pool, then put bytesToLeave bytes of the last one back.
+ */
+void
+TestRegionEvacuatorHeap::exhaustMemoryPool(uintptr_t bytesToLeave)
+{
+    void *lastBase = NULL;
+    void *lastTop = NULL;
+    void *addrBase = NULL;
+    void *addrTop = NULL;
+    while (true) {
+        MM_AllocateDescription allocDescription(0, 0, false, true);
+        if (NULL == subSpace->collectorAllocateTLH(env, extensions->getGlobalCollector(), &allocDescription, UDATA_MAX, addrBase, addrTop)) {
+            break;
+        }
+        if (NULL != lastBase) {
+            MM_HeapLinkedFreeHeader::fillWithHoles(lastBase, (uintptr_t)lastTop - (uintptr_t)lastBase);
+        }
+        lastBase = addrBase;
+        lastTop = addrTop;
+    }
+    ASSERT_TRUE(NULL != lastBase);
+    ASSERT_LE(bytesToLeave, (uintptr_t)lastTop - (uintptr_t)lastBase);
+    void *splitPoint = (void *)((uintptr_t)lastTop - bytesToLeave);
+    MM_HeapLinkedFreeHeader::fillWithHoles(lastBase, (uintptr_t)splitPoint - (uintptr_t)lastBase);
+    subSpace->getMemoryPool()->expandWithRange(env, bytesToLeave, splitPoint, lastTop, false);
+}
+
+void
+TestRegionEvacuatorHeap::evacuate()
+{
+    MM_RegionEvacuationTask evacuationTask(env, extensions->dispatcher, evacuator, markMap);
+    extensions->dispatcher->run(env, &evacuationTask);
+}
+
+/**
+ * Check that original has been forwarded to an identical, marked copy outside of the evacuation set.
+ */
+void
+TestRegionEvacuatorHeap::verifyCopy(Object *original)
+{
+    MM_ForwardedHeader forwardedHeader((omrobjectptr_t)original);
+    ASSERT_TRUE(forwardedHeader.isForwardedPointer());
+    Object *copy = (Object *)evacuator->getForwardedObject((omrobjectptr_t)original);
+    ASSERT_NE(original, copy);
+    EXPECT_FALSE(evacuator->isInEvacuationSet(copy));
+    EXPECT_TRUE(markMap->isBitSet((omrobjectptr_t)copy));
+    EXPECT_EQ(OBJECT_SIZE, copy->header.sizeInBytes());
+    EXPECT_EQ(0, memcmp(original->begin() + 1, copy->begin() + 1, OBJECT_SIZE - sizeof(ObjectHeader) - sizeof(Slot)));
+}
+
+TEST_F(TestRegionEvacuatorHeap, EvacuateAndReclaim)
+{
+    /* a quarter of the first region and half of the second one are live */
+    populateRegion(0, 4);
+    populateRegion(1, 2);
+
+    EXPECT_EQ(0, evacuator->selectEvacuationSet(env, markMap, 2, 20));
+    EXPECT_EQ(0, evacuator->reclaimEvacuatedRegions(env, markMap));
+    EXPECT_EQ(1, evacuator->selectEvacuationSet(env, markMap, 2, 30));
+    EXPECT_EQ(0, evacuator->reclaimEvacuatedRegions(env, markMap));
+    ASSERT_EQ(2, evacuator->selectEvacuationSet(env, markMap, 2, 60));
+    EXPECT_TRUE(evacuator->isInEvacuationSet(sourceRegions[0]->getLowAddress()));
+    EXPECT_TRUE(evacuator->isInEvacuationSet(sourceRegions[1]->getLowAddress()));
+
+    evacuate();
+
+    uintptr_t liveCount = liveObjects[0].size() + liveObjects[1].size();
+    EXPECT_EQ(liveCount, evacuator->getObjectsCopied());
+    EXPECT_EQ(liveCount * OBJECT_SIZE, evacuator->getBytesCopied());
+    EXPECT_LE(1, evacuator->getCopyChunksAcquired());
+
+    for (uintptr_t index = 0; index < 2; index++) {
+        for (std::vector<Object *>::iterator it = liveObjects[index].begin(); it != liveObjects[index].end(); ++it) {
+            verifyCopy(*it);
+            /* references into the evacuation set are fixed up to the copies */
+            Object *copy = (Object *)evacuator->getForwardedObject((omrobjectptr_t)*it);
+            GC_SlotObject slotObject(exampleVM->_omrVM, copy->begin());
+            omrobjectptr_t referent = slotObject.readReferenceFromSlot();
+            if (NULL == referent) {
+                continue;
+            }
+            evacuator->fixupSlot(&slotObject);
+            EXPECT_EQ(evacuator->getForwardedObject(referent), slotObject.readReferenceFromSlot());
+            EXPECT_FALSE(evacuator->isInEvacuationSet(slotObject.readReferenceFromSlot()));
+        }
+    }
+
+    EXPECT_EQ(2, evacuator->reclaimEvacuatedRegions(env, markMap));
+    EXPECT_EQ(2, evacuator->getRegionsReclaimed());
+    for (uintptr_t index = 0; index < 2; index++) {
+        EXPECT_FALSE(evacuator->isInEvacuationSet(sourceRegions[index]->getLowAddress()));
+        EXPECT_TRUE(markMap->checkBitsForRegion(env, sourceRegions[index]));
+    }
+}
+
+TEST_F(TestRegionEvacuatorHeap, DestinationExhausted)
+{
+    populateRegion(0, 2);
+    populateRegion(1, 2);
+    uintptr_t liveCount = liveObjects[0].size() + liveObjects[1].size();
+
+    /* leave room for a few objects only */
+    exhaustMemoryPool(8 * OBJECT_SIZE);
+    ASSERT_EQ(2, evacuator->selectEvacuationSet(env, markMap, 2, 60));
+
+    evacuate();
+
+    uintptr_t copied = evacuator->getObjectsCopied();
+    EXPECT_LT(0, copied);
+    EXPECT_GT(liveCount, copied);
+    EXPECT_EQ(copied * OBJECT_SIZE, evacuator->getBytesCopied());
+
+    uintptr_t forwarded = 0;
+    for (uintptr_t index = 0; index < 2; index++) {
+        for (std::vector<Object *>::iterator it = liveObjects[index].begin(); it != liveObjects[index].end(); ++it) {
+            MM_ForwardedHeader forwardedHeader((omrobjectptr_t)*it);
+            if (forwardedHeader.isForwardedPointer()) {
+                verifyCopy(*it);
+                forwarded += 1;
+            } else {
+                /* objects which did not fit stay in place, intact and marked */
+                EXPECT_EQ((omrobjectptr_t)*it, evacuator->getForwardedObject((omrobjectptr_t)*it));
+                EXPECT_EQ(OBJECT_SIZE, (*it)->header.sizeInBytes());
+                EXPECT_TRUE(markMap->isBitSet((omrobjectptr_t)*it));
+            }
+        }
+    }
+    EXPECT_EQ(copied, forwarded);
+
+    /* neither region was emptied; the originals of copied objects are unmarked, the rest stay live */
+    EXPECT_EQ(0, evacuator->reclaimEvacuatedRegions(env, markMap));
+    for (uintptr_t index = 0; index < 2; index++) {
+        for (std::vector<Object *>::iterator it = liveObjects[index].begin(); it != liveObjects[index].end(); ++it) {
+            MM_ForwardedHeader forwardedHeader((omrobjectptr_t)*it);
+            EXPECT_NE(forwardedHeader.isForwardedPointer(), markMap->isBitSet((omrobjectptr_t)*it));
+        }
+    }
+}
+
+#endif /* defined(OMR_GC_VLHGC) */
@@ -57,6 +57,7 @@ GCTestEnvironment::GCTestSetUp()
 	exampleVM._omrVMThread = NULL;
 	exampleVM._vmAccessMutex = NULL;
 	exampleVM._vmExclusiveAccessCount = 0;
+	exampleVM._vmAccessReacquireCount = 0;
 
 	/* Attach main test thread */
 	intptr_t irc = omrthread_attach_ex(&exampleVM.self, J9THREAD_ATTR_DEFAULT);
@@ -0,0 +1,256 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "omrcfg.h"
+#include "omrport.h"
+#include "mmomrhook_internal.h"
+
+#if defined(LINUX) || defined(AIXPPC)
+#include <ucontext.h>
+#endif /* defined(LINUX) || defined(AIXPPC) */
+
+#include "AllocationSampler.hpp"
+
+#include "AtomicOperations.hpp"
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
+
+/* room for the frames of a backtrace, and the management overhead of the heap they are allocated from */
+#define ALLOCATION_SAMPLER_BACKTRACE_HEAP_SIZE (2 * (MM_AllocationSampler::MAX_FRAMES + 16) * (sizeof(J9PlatformStackFrame) + sizeof(uint64_t)))
+
+MM_AllocationSampler *
+MM_AllocationSampler::newInstance(MM_EnvironmentBase *env, uintptr_t topSiteCount)
+{
+	MM_AllocationSampler *sampler = (MM_AllocationSampler *)env->getForge()->allocate(sizeof(MM_AllocationSampler), OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL != sampler) {
+		new(sampler) MM_AllocationSampler(env);
+		if (!sampler->initialize(env, topSiteCount)) {
+			sampler->kill(env);
+			sampler = NULL;
+		}
+	}
+	return sampler;
+}
+
+void
+MM_AllocationSampler::kill(MM_EnvironmentBase *env)
+{
+	tearDown(env);
+	env->getForge()->free(this);
+}
+
+MM_AllocationSampler::MM_AllocationSampler(MM_EnvironmentBase *env)
+	: MM_BaseVirtual()
+	, _extensions(env->getExtensions())
+	, _lock()
+	, _topSites(NULL)
+	, _sites(NULL)
+	, _siteCount(0)
+	, _skipFrames(0)
+	, _sampleCount(0)
+{
+	_typeId = __FUNCTION__;
+}
+
+bool
+MM_AllocationSampler::initialize(MM_EnvironmentBase *env, uintptr_t topSiteCount)
+{
+	if (0 == topSiteCount) {
+		return false;
+	}
+
+	if (!_lock.initialize(env, &_extensions->lnrlOptions, "MM_AllocationSampler:_lock")) {
+		return false;
+	}
+
+	_topSites = spaceSavingNew(env->getPortLibrary(), (uint32_t)topSiteCount);
+	if (NULL == _topSites) {
+		return false;
+	}
+
+	/* keep twice as many call stacks as tracked keys so that few top sites collide */
+	_siteCount = 2 * topSiteCount;
+	_sites = (AllocationSite *)env->getForge()->allocate(sizeof(AllocationSite) * _siteCount, OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL == _sites) {
+		return false;
+	}
+	memset(_sites, 0, sizeof(AllocationSite) * _siteCount);
+
+	/* Two captures from different call sites only share the frames of the backtrace machinery,
+	 * which are dropped from every sample.
+	 */
+	uintptr_t first[MAX_FRAMES];
+	uintptr_t second[MAX_FRAMES];
+	uintptr_t firstCount = captureFrames(env, first, 0);
+	uintptr_t secondCount = captureFrames(env, second, 0);
+	while ((_skipFrames < firstCount) && (_skipFrames < secondCount) && (first[_skipFrames] == second[_skipFrames])) {
+		_skipFrames += 1;
+	}
+	if ((_skipFrames == firstCount) || (_skipFrames == secondCount)) {
+		_skipFrames = 0;
+	}
+
+	return true;
+}
+
+void
+MM_AllocationSampler::tearDown(MM_EnvironmentBase *env)
+{
+	if (NULL != _sites) {
+		env->getForge()->free(_sites);
+		_sites = NULL;
+	}
+	if (NULL != _topSites) {
+		spaceSavingFree(_topSites);
+		_topSites = NULL;
+	}
+	_lock.tearDown();
+}
+
+/**
+ * Capture the return addresses of the current thread's call stack, innermost first.
+ * @param frames an array of MAX_FRAMES entries to fill in
+ * @param skipFrames the number of innermost frames to leave out
+ * @return the number of frames captured, 0 where the platform cannot walk the current thread
+ */
+uintptr_t
+MM_AllocationSampler::captureFrames(MM_EnvironmentBase *env, uintptr_t *frames, uintptr_t skipFrames)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(env->getPortLibrary());
+	uintptr_t frameCount = 0;
+
+#if defined(LINUX) || defined(AIXPPC)
+	/* frames are allocated from a heap on the stack so that a sample never calls malloc */
+	uint64_t heapStorage[ALLOCATION_SAMPLER_BACKTRACE_HEAP_SIZE / sizeof(uint64_t)];
+	J9Heap *heap = omrheap_create(heapStorage, sizeof(heapStorage), 0);
+	if (NULL != heap) {
+		ucontext_t context;
+		J9PlatformThread thread;
+		memset(&thread, 0, sizeof(thread));
+		if (0 == getcontext(&context)) {
+			thread.context = &context;
+			omrintrospect_backtrace_thread(&thread, heap, NULL);
+		}
+		uintptr_t index = 0;
+		for (J9PlatformStackFrame *frame = thread.callstack; (NULL != frame) && (frameCount < MAX_FRAMES); frame = frame->parent_frame) {
+			if (index >= skipFrames) {
+				frames[frameCount] = frame->instruction_pointer;
+				frameCount += 1;
+			}
+			index += 1;
+		}
+	}
+#endif /* defined(LINUX) || defined(AIXPPC) */
+
+	return frameCount;
+}
+
+uintptr_t
+MM_AllocationSampler::hashFrames(uintptr_t *frames, uintptr_t frameCount)
+{
+	uintptr_t hash = frameCount;
+	for (uintptr_t i = 0; i < frameCount; i++) {
+		hash = (hash * 31) ^ frames[i];
+	}
+	/* 0 marks an unused site entry */
+	return (0 == hash) ? 1 : hash;
+}
+
+/**
+ * @return true if key is one of the keys currently tracked by the space-saving table
+ */
+bool
+MM_AllocationSampler::isTopSite(uintptr_t key)
+{
+	uintptr_t tracked = spaceSavingGetCurSize(_topSites);
+	for (uintptr_t k = 1; k <= tracked; k++) {
+		if (key == (uintptr_t)spaceSavingGetKthMostFreq(_topSites, k)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void
+MM_AllocationSampler::sample(MM_EnvironmentBase *env, omrobjectptr_t object, uintptr_t size, uintptr_t sampledBytes)
+{
+	uintptr_t frames[MAX_FRAMES];
+	uintptr_t frameCount = captureFrames(env, frames, _skipFrames);
+
+	MM_AtomicOperations::add(&_sampleCount, 1);
+
+	TRIGGER_J9HOOK_MM_OMR_ALLOCATION_SAMPLE(
+		_extensions->omrHookInterface,
+		env->getOmrVMThread(),
+		object,
+		size,
+		sampledBytes,
+		frames,
+		frameCount);
+
+	uintptr_t key = hashFrames(frames, frameCount);
+	_lock.acquire();
+	spaceSavingUpdate(_topSites, (void *)key, sampledBytes);
+	/* keep the call stack of the key unless its entry holds a site which is still tracked */
+	AllocationSite *site = &_sites[key % _siteCount];
+	if ((key != site->_key) && ((0 == site->_key) || !isTopSite(site->_key))) {
+		site->_key = key;
+		site->_frameCount = frameCount;
+		memcpy(site->_frames, frames, sizeof(uintptr_t) * frameCount);
+	}
+	_lock.release();
+}
+
+uintptr_t
+MM_AllocationSampler::getTopSites(MM_EnvironmentBase *env, AllocationSite *sites, uintptr_t maxSites)
+{
+	uintptr_t count = 0;
+
+	_lock.acquire();
+	uintptr_t tracked = spaceSavingGetCurSize(_topSites);
+	for (uintptr_t k = 1; (k <= tracked) && (count < maxSites); k++) {
+		uintptr_t key = (uintptr_t)spaceSavingGetKthMostFreq(_topSites, k);
+		AllocationSite *site = &_sites[key % _siteCount];
+		sites[count]._key = key;
+		sites[count]._bytes = spaceSavingGetKthMostFreqCount(_topSites, k);
+		if (key == site->_key) {
+			sites[count]._frameCount = site->_frameCount;
+			memcpy(sites[count]._frames, site->_frames, sizeof(uintptr_t) * site->_frameCount);
+		} else {
+			/* the call stack was displaced by another top site */
+			sites[count]._frameCount = 0;
+		}
+		count += 1;
+	}
+	_lock.release();
+
+	return count;
+}
+
+void
+MM_AllocationSampler::reset(MM_EnvironmentBase *env)
+{
+	_lock.acquire();
+	spaceSavingClear(_topSites);
+	memset(_sites, 0, sizeof(AllocationSite) * _siteCount);
+	_lock.release();
+}
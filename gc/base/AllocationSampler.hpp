@@ -0,0 +1,118 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(ALLOCATIONSAMPLER_HPP_)
+#define ALLOCATIONSAMPLER_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "spacesaving.h"
+
+#include "BaseVirtual.hpp"
+#include "LightweightNonReentrantLock.hpp"
+
+class MM_EnvironmentBase;
+class MM_GCExtensionsBase;
+
+/**
+ * Byte-interval allocation sampling.
+ *
+ * The allocation interface accumulates the bytes each thread allocates whenever it refreshes its TLH
+ * or allocates out of line, and calls sample() once every allocationSamplingBytesGranularity bytes.
+ * TLH allocations themselves are never inspected. Each sample captures the allocating call stack
+ * with omrintrospect_backtrace_thread(), reports it through J9HOOK_MM_OMR_ALLOCATION_SAMPLE and
+ * charges the sampled bytes to the call stack in a space-saving table, from which the heaviest
+ * allocation sites can be read at any time with getTopSites().
+ * @ingroup GC_Base
+ */
+class MM_AllocationSampler : public MM_BaseVirtual
+{
+	/*
+	 * Data members
+	 */
+public:
+	enum {
+		MAX_FRAMES = 32 /**< innermost frames of an allocating call stack which are captured */
+	};
+
+	/**
+	 * An allocating call stack and the number of bytes sampled for it.
+	 */
+	struct AllocationSite {
+		uintptr_t _key; /**< hash of the call stack, 0 for an unused entry */
+		uintptr_t _bytes; /**< bytes sampled at the site, estimate from the space-saving table */
+		uintptr_t _frameCount; /**< the number of entries in _frames */
+		uintptr_t _frames[MAX_FRAMES]; /**< return addresses, innermost first */
+	};
+
+private:
+	MM_GCExtensionsBase *_extensions;
+	MM_LightweightNonReentrantLock _lock; /**< serializes updates of the site tables */
+	OMRSpaceSaving *_topSites; /**< sampled bytes per call stack key */
+	AllocationSite *_sites; /**< call stacks of the keys in _topSites, direct mapped by key */
+	uintptr_t _siteCount; /**< number of entries in _sites */
+	uintptr_t _skipFrames; /**< leading frames of a capture which belong to the backtrace machinery */
+	volatile uintptr_t _sampleCount; /**< number of samples taken */
+
+	/*
+	 * Function members
+	 */
+public:
+	static MM_AllocationSampler *newInstance(MM_EnvironmentBase *env, uintptr_t topSiteCount);
+	virtual void kill(MM_EnvironmentBase *env);
+
+	/**
+	 * Take a sample of an allocation made by the thread of env.
+	 * @param object the object which has just been allocated
+	 * @param size the size of the object in bytes
+	 * @param sampledBytes the bytes allocated by the thread since its previous sample
+	 */
+	void sample(MM_EnvironmentBase *env, omrobjectptr_t object, uintptr_t size, uintptr_t sampledBytes);
+
+	/**
+	 * Copy the allocation sites with the most sampled bytes, heaviest first.
+	 * @param sites the array to fill in
+	 * @param maxSites the number of entries in sites
+	 * @return the number of sites copied
+	 */
+	uintptr_t getTopSites(MM_EnvironmentBase *env, AllocationSite *sites, uintptr_t maxSites);
+
+	/**
+	 * Forget all sites sampled so far.
+	 */
+	void reset(MM_EnvironmentBase *env);
+
+	MMINLINE uintptr_t getSampleCount() const { return _sampleCount; }
+
+	MM_AllocationSampler(MM_EnvironmentBase *env);
+
+protected:
+	bool initialize(MM_EnvironmentBase *env, uintptr_t topSiteCount);
+	void tearDown(MM_EnvironmentBase *env);
+
+private:
+	uintptr_t captureFrames(MM_EnvironmentBase *env, uintptr_t *frames, uintptr_t skipFrames);
+	static uintptr_t hashFrames(uintptr_t *frames, uintptr_t frameCount);
+	bool isTopSite(uintptr_t key);
+};
+
+#endif /* ALLOCATIONSAMPLER_HPP_ */
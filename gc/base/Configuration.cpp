@@ -30,6 +30,8 @@
 
 #include "Configuration.hpp"
 
+#include "AllocationSampler.hpp"
+
 #include "Debug.hpp"
 #include "EnvironmentBase.hpp"
 #include "GCExtensionsBase.hpp"
@@ -74,6 +76,10 @@ MM_Configuration::initialize(MM_EnvironmentBase* env)
 				initializeGCParameters(env);
 				extensions->_lightweightNonReentrantLockPool = pool_new(sizeof(J9ThreadMonitorTracing), 0, 0, 0, OMR_GET_CALLSITE(), OMRMEM_CATEGORY_MM, POOL_FOR_PORT(env->getPortLibrary()));
 				result = (NULL != extensions->_lightweightNonReentrantLockPool);
+				if (result && (0 != extensions->allocationSamplingBytesGranularity)) {
+					extensions->allocationSampler = MM_AllocationSampler::newInstance(env, extensions->allocationSamplingTopSiteCount);
+					result = (NULL != extensions->allocationSampler);
+				}
 			}
 		}
 	}
@@ -136,6 +142,11 @@ MM_Configuration::tearDown(MM_EnvironmentBase* env)
 		extensions->heapRegionManager = NULL;
 	}
 
+	if (NULL != extensions->allocationSampler) {
+		extensions->allocationSampler->kill(env);
+		extensions->allocationSampler = NULL;
+	}
+
 	if (NULL != extensions->_lightweightNonReentrantLockPool) {
 		pool_kill(extensions->_lightweightNonReentrantLockPool);
 		extensions->_lightweightNonReentrantLockPool = NULL;
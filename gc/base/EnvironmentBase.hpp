@@ -38,6 +38,7 @@
 #include "LargeObjectAllocateStats.hpp"
 #include "MarkStats.hpp"
 #include "RootScannerStats.hpp"
+#include "SATBBarrierStats.hpp"
 #include "ScavengerStats.hpp"
 #include "SweepStats.hpp"
 #include "WorkPacketStats.hpp"
@@ -147,6 +148,7 @@ public:
 	MM_FreeEntrySizeClassStats _freeEntrySizeClassStats;  /**< GC thread local statistics structure for heap free entry size (sizeClass) distribution */
 
 	uintptr_t _oolTraceAllocationBytes; /**< Tracks the bytes allocated since the last ool object trace */
+	uintptr_t _allocationSamplingBytes; /**< Tracks the bytes allocated since the last allocation sample */
 
 	MM_Validator *_activeValidator; /**< Used to identify and report crashes inside Validators */
 
@@ -163,6 +165,9 @@ public:
 	volatile uint32_t _allocationColor; /**< Flag field to indicate whether premarking is enabled on the thread */
 
 	MM_CardCleaningStats _cardCleaningStats; /**< Per thread stats to track the performance of the card cleaning */
+#if defined(OMR_GC_REALTIME)
+	MM_SATBBarrierStats _sATBBarrierStats; /**< Per thread stats for the snapshot at the beginning barrier buffers, merged at the final collection */
+#endif /* OMR_GC_REALTIME */
 #if defined(OMR_GC_MODRON_STANDARD) || defined(OMR_GC_REALTIME)
 	MM_SweepStats _sweepStats;
 #if defined(OMR_GC_MODRON_COMPACTION)
@@ -640,6 +645,7 @@ public:
 		,_slaveThreadCpuTimeNanos(0)
 		,_freeEntrySizeClassStats()
 		,_oolTraceAllocationBytes(0)
+		,_allocationSamplingBytes(0)
 		,_activeValidator(NULL)
 		,_lastSyncPointReached(NULL)
 #if defined(OMR_GC_SEGREGATED_HEAP)
@@ -691,6 +697,7 @@ public:
 		,_slaveThreadCpuTimeNanos(0)
 		,_freeEntrySizeClassStats()
 		,_oolTraceAllocationBytes(0)
+		,_allocationSamplingBytes(0)
 		,_activeValidator(NULL)
 		,_lastSyncPointReached(NULL)
 #if defined(OMR_GC_SEGREGATED_HEAP)
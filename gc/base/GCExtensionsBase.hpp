@@ -47,6 +47,7 @@
 #include "ScavengerStats.hpp"
 #include "SublistPool.hpp"
 
+class MM_AllocationSampler;
 class MM_CardTable;
 class MM_ClassLoaderRememberedSet;
 class MM_CollectorLanguageInterface;
@@ -74,6 +75,7 @@ class MM_RememberedSetCardBucket;
 class MM_RememberedSetSATB;
 #endif /* defined(OMR_GC_REALTIME) */
 #if defined(OMR_GC_MODRON_SCAVENGER)
+class MM_NurseryRegionMap;
 class MM_Scavenger;
 #endif /* OMR_GC_MODRON_SCAVENGER */
 class MM_SizeClasses;
@@ -230,6 +232,7 @@ public:
 
 #if defined(OMR_GC_MODRON_SCAVENGER)
 	MM_Scavenger *scavenger;
+	MM_NurseryRegionMap *nurseryRegionMap; /**< One bit per heap region for nursery membership, maintained by MM_MemorySubSpaceSemiSpace */
 	void *_masterThreadTenureTLHRemainderBase;  /**< base and top pointers of the last unused tenure TLH copy cache, that will be loaded to thread env during master setup */
 	void *_masterThreadTenureTLHRemainderTop;
 #endif /* OMR_GC_MODRON_SCAVENGER */
@@ -289,6 +292,9 @@ public:
 	uintptr_t frequentObjectAllocationSamplingRate; /**< # bytes to sample / # bytes allocated */
 	MM_FrequentObjectsStats* frequentObjectsStats;
 	uint32_t frequentObjectAllocationSamplingDepth; /**< # of frequent objects we'd like to report */
+	uintptr_t allocationSamplingBytesGranularity; /**< How often (in bytes allocated per thread) an allocation is sampled, 0 to disable allocation sampling */
+	uintptr_t allocationSamplingTopSiteCount; /**< # of allocation sites tracked by the allocation sampler */
+	MM_AllocationSampler* allocationSampler; /**< Attributes sampled allocations to call sites, NULL unless allocation sampling is enabled */
 
 	uint32_t estimateFragmentation; /**< Enable estimate fragmentation, NO_ESTIMATE_FRAGMENTATION, LOCALGC_ESTIMATE_FRAGMENTATION, GLOBALGC_ESTIMATE_FRAGMENTATION(default) */
 	bool processLargeAllocateStats; /**< Enable process LargeObjectAllocateStats */
@@ -526,6 +532,7 @@ public:
 	double concurrentSlackFragmentationAdjustmentWeight; /**< weight(from 0.0 to 5.0) used for calculating free tenure space (how much percentage of the fragmentation need to remove from freeBytes) */
 	bool debugConcurrentMark;
 	bool optimizeConcurrentWB;
+	bool concurrentScanThreadRootsAtSafepoint; /**< Mutator threads scan their own roots from a safepoint callback once concurrent root tracing starts */
 	bool dirtCardDuringRSScan;
 	uintptr_t concurrentLevel;
 	uintptr_t concurrentBackground;
@@ -1283,6 +1290,7 @@ public:
 		, _tenureSize(0)
 #if defined(OMR_GC_MODRON_SCAVENGER)
 		, scavenger(NULL)
+		, nurseryRegionMap(NULL)
 		, _masterThreadTenureTLHRemainderBase(NULL)
 		, _masterThreadTenureTLHRemainderTop(NULL)
 #endif /* OMR_GC_MODRON_SCAVENGER */
@@ -1330,6 +1338,9 @@ public:
 		, frequentObjectAllocationSamplingRate(100)
 		, frequentObjectsStats(NULL)
 		, frequentObjectAllocationSamplingDepth(0)
+		, allocationSamplingBytesGranularity(0)
+		, allocationSamplingTopSiteCount(32)
+		, allocationSampler(NULL)
 		, estimateFragmentation(GLOBALGC_ESTIMATE_FRAGMENTATION)
 		, processLargeAllocateStats(true) /* turn on processLargeAllocateStats by default */
 		, largeObjectAllocationProfilingThreshold(512)
@@ -1519,6 +1530,7 @@ public:
 		, concurrentSlackFragmentationAdjustmentWeight(0.0)
 		, debugConcurrentMark(false)
 		, optimizeConcurrentWB(true)
+		, concurrentScanThreadRootsAtSafepoint(false)
 		, dirtCardDuringRSScan(false)
 		, concurrentLevel(8)
 		, concurrentBackground(1)
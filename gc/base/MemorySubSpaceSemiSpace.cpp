@@ -37,6 +37,7 @@
 #include "MemorySubSpace.hpp"
 #include "MemorySubSpaceRegionIterator.hpp"
 #include "MemorySubSpaceSemiSpace.hpp"
+#include "NurseryRegionMap.hpp"
 #include "PhysicalSubArena.hpp"
 
 #if defined(OMR_VALGRIND_MEMCHECK)
@@ -432,6 +433,15 @@ MM_MemorySubSpaceSemiSpace::initialize(MM_EnvironmentBase *env)
 		return false;
 	}
 
+	MM_Heap *heap = _extensions->heap;
+	_nurseryRegionMap = MM_NurseryRegionMap::newInstance(env, heap->getHeapBase(), heap->getHeapTop(), heap->getHeapRegionManager()->getRegionShift());
+	if (NULL == _nurseryRegionMap) {
+		return false;
+	}
+	if (NULL == _extensions->nurseryRegionMap) {
+		_extensions->nurseryRegionMap = _nurseryRegionMap;
+	}
+
 	return true;
 }
 
@@ -444,6 +454,26 @@ MM_MemorySubSpaceSemiSpace::tearDown(MM_EnvironmentBase *env)
 		_largeObjectAllocateStats->kill(env);
 		_largeObjectAllocateStats = NULL;
 	}
+
+	if (NULL != _nurseryRegionMap) {
+		if (_extensions->nurseryRegionMap == _nurseryRegionMap) {
+			_extensions->nurseryRegionMap = NULL;
+		}
+		_nurseryRegionMap->kill(env);
+		_nurseryRegionMap = NULL;
+	}
+}
+
+/**
+ * Memory has moved between, into or out of the semi spaces (inflate, expand, contract or tilt).
+ * Refresh the nursery region map before the barrier next consults it.
+ */
+void
+MM_MemorySubSpaceSemiSpace::heapReconfigured(MM_EnvironmentBase *env)
+{
+	rebuildNurseryRegionMap();
+
+	MM_MemorySubSpace::heapReconfigured(env);
 }
 
 /****************************************
@@ -590,6 +620,26 @@ MM_MemorySubSpaceSemiSpace::cacheRanges(MM_MemorySubSpace *subSpace, void **base
 	*top = region->getHighAddress();
 }
 
+/**
+ * Set the nursery region map to exactly the regions currently owned by the allocate and survivor spaces.
+ */
+void
+MM_MemorySubSpaceSemiSpace::rebuildNurseryRegionMap()
+{
+	if (NULL != _nurseryRegionMap) {
+		_nurseryRegionMap->clear();
+
+		MM_MemorySubSpace *children[] = { _memorySubSpaceAllocate, _memorySubSpaceSurvivor };
+		for (uintptr_t i = 0; i < sizeof(children) / sizeof(children[0]); i++) {
+			GC_MemorySubSpaceRegionIterator regionIterator(children[i]);
+			MM_HeapRegionDescriptor *region = NULL;
+			while (NULL != (region = regionIterator.nextRegion())) {
+				_nurseryRegionMap->setRange(region->getLowAddress(), region->getHighAddress(), true);
+			}
+		}
+	}
+}
+
 void
 MM_MemorySubSpaceSemiSpace::masterSetupForGC(MM_EnvironmentBase *env)
 {
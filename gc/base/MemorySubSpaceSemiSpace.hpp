@@ -36,6 +36,7 @@ class MM_EnvironmentBase;
 class MM_HeapStats;
 class MM_MemoryPool;
 class MM_MemorySpace;
+class MM_NurseryRegionMap;
 class MM_PhysicalSubArena;
 class MM_ObjectAllocationInterface;
 
@@ -84,6 +85,7 @@ private:
 #endif /* OMR_GC_CONCURRENT_SCAVENGER */
 
 	MM_LargeObjectAllocateStats *_largeObjectAllocateStats; /**< Approximate allocation profile for large objects. Struct to keep merged stats from two allocate pools */
+	MM_NurseryRegionMap *_nurseryRegionMap; /**< Regions currently owned by the allocate and survivor spaces, published as MM_GCExtensionsBase::nurseryRegionMap */
 
 protected:
 public:
@@ -132,6 +134,7 @@ public:
 	void poisonEvacuateSpace();
 
 	void cacheRanges(MM_MemorySubSpace *subSpace, void **base, void **top);
+	void rebuildNurseryRegionMap();
 
 	MM_MemorySubSpace *getTenureMemorySubSpace() { 	return _parent->getTenureMemorySubSpace(); }
 	MM_MemorySubSpace *getMemorySubSpaceAllocate() { return _memorySubSpaceAllocate; };
@@ -153,6 +156,7 @@ public:
 	virtual	void mergeHeapStats(MM_HeapStats *heapStats);
 	virtual	void mergeHeapStats(MM_HeapStats *heapStats, uintptr_t includeMemoryType);
 	virtual void systemGarbageCollect(MM_EnvironmentBase *env, uint32_t gcCode);
+	virtual void heapReconfigured(MM_EnvironmentBase *env);
 
 	/* Type specific methods */
 	void flip(MM_EnvironmentBase *env, Flip_step action);
@@ -193,6 +197,8 @@ public:
 		,_bytesAllocatedDuringConcurrent(0)
 		,_avgBytesAllocatedDuringConcurrent(0)
 #endif /* OMR_GC_CONCURRENT_SCAVENGER */ 		
+		,_largeObjectAllocateStats(NULL)
+		,_nurseryRegionMap(NULL)
 	{
 		_typeId = __FUNCTION__;
 	}
@@ -75,6 +75,14 @@ public:
 		return (uintptr_t)(_topPtr - _currentPtr);
 	}
 
+	/**
+	 * Returns the number of used slots
+	 */
+	MMINLINE uintptr_t usedSlots()
+	{
+		return (uintptr_t)(_currentPtr - _basePtr);
+	}
+
 	/**
 	 * Sets the address of the owning threads env
 	 */
@@ -50,6 +50,14 @@
 #define OMR_XGCBUFFERED_LOGGING_LENGTH 20
 #define OMR_XGCTHREADS "-Xgcthreads"
 #define OMR_XGCTHREADS_LENGTH 11
+#define OMR_XGCALLOCATION_SAMPLING_INTERVAL "-Xgc:allocationSamplingInterval="
+#define OMR_XGCALLOCATION_SAMPLING_INTERVAL_LENGTH 32
+#define OMR_XGCALLOCATION_SAMPLING_TOP_SITES "-Xgc:allocationSamplingTopSites="
+#define OMR_XGCALLOCATION_SAMPLING_TOP_SITES_LENGTH 32
+#if defined(OMR_GC_MODRON_CONCURRENT_MARK)
+#define OMR_XGCCONCURRENT_SCAN_THREAD_ROOTS_AT_SAFEPOINT "-Xgc:concurrentScanThreadRootsAtSafepoint"
+#define OMR_XGCCONCURRENT_SCAN_THREAD_ROOTS_AT_SAFEPOINT_LENGTH 41
+#endif /* defined(OMR_GC_MODRON_CONCURRENT_MARK) */
 
 uintptr_t
 MM_StartupManager::getUDATAValue(char *option, uintptr_t *outputValue)
@@ -295,7 +303,27 @@ MM_StartupManager::handleOption(MM_GCExtensionsBase *extensions, char *option)
 			extensions->gcThreadCount = forcedThreadCount;
 			extensions->gcThreadCountForced = true;
 		}
-	} else {
+	} else if (0 == strncmp(option, OMR_XGCALLOCATION_SAMPLING_INTERVAL, OMR_XGCALLOCATION_SAMPLING_INTERVAL_LENGTH)) {
+		uintptr_t value = 0;
+		if (!getUDATAMemoryValue(option + OMR_XGCALLOCATION_SAMPLING_INTERVAL_LENGTH, &value)) {
+			result = false;
+		} else {
+			extensions->allocationSamplingBytesGranularity = value;
+		}
+	} else if (0 == strncmp(option, OMR_XGCALLOCATION_SAMPLING_TOP_SITES, OMR_XGCALLOCATION_SAMPLING_TOP_SITES_LENGTH)) {
+		uintptr_t value = 0;
+		if ((0 >= getUDATAValue(option + OMR_XGCALLOCATION_SAMPLING_TOP_SITES_LENGTH, &value)) || (0 == value)) {
+			result = false;
+		} else {
+			extensions->allocationSamplingTopSiteCount = value;
+		}
+	}
+#if defined(OMR_GC_MODRON_CONCURRENT_MARK)
+	else if (0 == strcmp(option, OMR_XGCCONCURRENT_SCAN_THREAD_ROOTS_AT_SAFEPOINT)) {
+		extensions->concurrentScanThreadRootsAtSafepoint = true;
+	}
+#endif /* defined(OMR_GC_MODRON_CONCURRENT_MARK) */
+	else {
 		/* unknown option */
 		result = false;
 	}
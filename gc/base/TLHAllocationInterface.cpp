@@ -35,6 +35,7 @@
 #include "ModronAssertions.h"
 
 #include "AllocateDescription.hpp"
+#include "AllocationSampler.hpp"
 #include "AllocationContext.hpp"
 #include "EnvironmentBase.hpp"
 #include "Forge.hpp"
@@ -209,7 +210,18 @@ MM_TLHAllocationInterface::allocateObject(MM_EnvironmentBase *env, MM_AllocateDe
 
 	}
 
-	env->_oolTraceAllocationBytes += (_stats.bytesAllocated() - _bytesAllocatedBase); /* Increment by bytes allocated */
+	uintptr_t bytesAllocated = _stats.bytesAllocated() - _bytesAllocatedBase;
+	env->_oolTraceAllocationBytes += bytesAllocated; /* Increment by bytes allocated */
+
+	/* bytesAllocated only moves on a TLH refresh or an out-of-line allocation */
+	MM_AllocationSampler *sampler = env->getExtensions()->allocationSampler;
+	if ((NULL != sampler) && (NULL != result)) {
+		env->_allocationSamplingBytes += bytesAllocated;
+		if (env->_allocationSamplingBytes >= env->getExtensions()->allocationSamplingBytesGranularity) {
+			sampler->sample(env, (omrobjectptr_t)result, allocDescription->getContiguousBytes(), env->_allocationSamplingBytes);
+			env->_allocationSamplingBytes = 0;
+		}
+	}
 
 	return result;
 }
@@ -71,6 +71,7 @@
 #include "MemorySubSpaceFlat.hpp"
 #include "MemorySubSpaceSemiSpace.hpp"
 #include "ObjectModel.hpp"
+#include "OMRVMThreadListIterator.hpp"
 #include "SpinLimiter.hpp"
 #include "SublistIterator.hpp"
 #include "SublistPuddle.hpp"
@@ -518,6 +519,27 @@ MM_ConcurrentGC::signalThreadsToActivateWriteBarrierAsyncEventHandler(OMR_VMThre
 	collector->signalThreadsToActivateWriteBarrier(env);
 }
 
+/**
+ * Async callback routine for a mutator thread to scan its own roots while other mutators keep running.
+ *
+ * @note Caller assumed to be at a safe point
+ *
+ */
+void
+MM_ConcurrentGC::scanThreadRootsAsyncEventHandler(OMR_VMThread *omrVMThread, void *userData)
+{
+	MM_ConcurrentGC *collector  = (MM_ConcurrentGC *)userData;
+	MM_EnvironmentBase *env = MM_EnvironmentBase::getEnvironment(omrVMThread);
+
+	if (!env->isThreadScanned()) {
+		collector->scanThread(env);
+		if (env->isThreadScanned()) {
+			/* Resume concurrent helper threads to help mark the roots we have just found */
+			collector->resumeConHelperThreads(env);
+		}
+	}
+}
+
 /**
  * Create new instance of ConcurrentGC object.
  *
@@ -577,6 +599,14 @@ MM_ConcurrentGC::initialize(MM_EnvironmentBase *env)
 		_callback->registerCallback(env, signalThreadsToActivateWriteBarrierAsyncEventHandler, this);
 	}
 
+	if (_extensions->concurrentScanThreadRootsAtSafepoint) {
+		_rootScanCallback = _concurrentDelegate.createSafepointCallback(env);
+		if (NULL == _rootScanCallback) {
+			goto error_no_memory;
+		}
+		_rootScanCallback->registerCallback(env, scanThreadRootsAsyncEventHandler, this);
+	}
+
 	if (_conHelperThreads > 0) {
 		/* Get storage for concurrent helper thread table */
 		_conHelpersTable = (omrthread_t *)env->getForge()->allocate(_conHelperThreads * sizeof(omrthread_t), OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
@@ -726,6 +756,11 @@ MM_ConcurrentGC::tearDown(MM_EnvironmentBase *env)
 		_callback = NULL;
 	}
 
+	if (NULL != _rootScanCallback) {
+		_rootScanCallback->kill(env);
+		_rootScanCallback = NULL;
+	}
+
 	/* ..and then tearDown our super class */
 	MM_ParallelGlobalGC::tearDown(env);
 }
@@ -2152,6 +2187,7 @@ MM_ConcurrentGC::concurrentMark(MM_EnvironmentBase *env, MM_MemorySubSpace *subs
 			if(_stats.switchExecutionMode(CONCURRENT_ROOT_TRACING, nextExecutionMode)) {
 				/* Signal threads for async callback to scan stack*/
 				_concurrentDelegate.signalThreadsToTraceStacks(env);
+				signalThreadsToScanRoots(env);
 				taxPaid = true;
 			}
 			break;
@@ -2197,6 +2233,34 @@ MM_ConcurrentGC::concurrentMark(MM_EnvironmentBase *env, MM_MemorySubSpace *subs
 	env->popVMstate(oldVMstate);
 }
 
+/**
+ * Ask every mutator thread to scan its own roots at its next safe point.
+ * Root scanning is spread over the mutators as each reaches a safe point rather than being
+ * done for all of them while they are stopped; any thread not scanned by the time the final
+ * collection starts is scanned by that collection as before.
+ */
+void
+MM_ConcurrentGC::signalThreadsToScanRoots(MM_EnvironmentBase *env)
+{
+	if (NULL != _rootScanCallback) {
+		OMR_VM *omrVM = env->getOmrVM();
+		uintptr_t threadCount = 0;
+
+		omrthread_monitor_enter(omrVM->_vmThreadListMutex);
+		GC_OMRVMThreadListIterator threadListIterator(omrVM);
+		OMR_VMThread *walkThread = NULL;
+		while (NULL != (walkThread = threadListIterator.nextOMRVMThread())) {
+			if (MUTATOR_THREAD == MM_EnvironmentBase::getEnvironment(walkThread)->getThreadType()) {
+				threadCount += 1;
+			}
+		}
+		omrthread_monitor_exit(omrVM->_vmThreadListMutex);
+
+		_stats.setThreadsToScanCount(threadCount);
+		_rootScanCallback->requestCallback(env);
+	}
+}
+
 void
 MM_ConcurrentGC::signalThreadsToActivateWriteBarrier(MM_EnvironmentBase *env)
 {
@@ -2296,6 +2360,7 @@ MM_ConcurrentGC::timeToKickoffConcurrent(MM_EnvironmentBase *env, MM_AllocateDes
 		if(_stats.switchExecutionMode(CONCURRENT_OFF, CONCURRENT_INIT_RUNNING)) {
 #if defined(OMR_GC_REALTIME)
 			if (_extensions->configuration->isSnapshotAtTheBeginningBarrierEnabled()) {
+				((MM_WorkPacketsSATB *)_markingScheme->getWorkPackets())->getBarrierStats()->clear();
 				_extensions->sATBBarrierRememberedSet->restoreGlobalFragmentIndex(env);
 			}
 #endif /* defined(OMR_GC_REALTIME) */
@@ -2968,10 +3033,16 @@ MM_ConcurrentGC::internalPreCollect(MM_EnvironmentBase *env, MM_MemorySubSpace *
 		if (_stats.switchExecutionMode(executionModeAtGC, CONCURRENT_OFF)) {
 #if defined(OMR_GC_REALTIME)
 			if (_extensions->configuration->isSnapshotAtTheBeginningBarrierEnabled()) {
-				if (((MM_WorkPacketsSATB *)_markingScheme->getWorkPackets())->inUsePacketsAvailable(env)) {
-					((MM_WorkPacketsSATB *)_markingScheme->getWorkPackets())->moveInUseToNonEmpty(env);
+				MM_WorkPacketsSATB *workPacketsSATB = (MM_WorkPacketsSATB *)_markingScheme->getWorkPackets();
+				workPacketsSATB->drainCompletedBarrierPackets(env);
+				if (workPacketsSATB->inUsePacketsAvailable(env)) {
+					workPacketsSATB->moveInUseToNonEmpty(env);
 					_extensions->sATBBarrierRememberedSet->flushFragments(env);
 				}
+				workPacketsSATB->mergeBarrierStats(env);
+				if (_extensions->debugConcurrentMark) {
+					workPacketsSATB->getBarrierStats()->printBarrierReport(env->getOmrVM());
+				}
 			}
 #endif /* defined(OMR_GC_REALTIME) */
 		}
@@ -3152,6 +3223,11 @@ MM_ConcurrentGC::internalPostCollect(MM_EnvironmentBase *env, MM_MemorySubSpace
 		_callback->cancelCallback(env);
 	}
 
+	if (NULL != _rootScanCallback) {
+		/* Threads which did not reach a safe point in time have been scanned by the collection */
+		_rootScanCallback->cancelCallback(env);
+	}
+
 	/* Call the super class to do any required work */
 	MM_ParallelGlobalGC::internalPostCollect(env, subSpace);
 
@@ -279,6 +279,7 @@ protected:
 	MM_ConcurrentMarkingDelegate _concurrentDelegate;
 
 	MM_ConcurrentSafepointCallback *_callback;
+	MM_ConcurrentSafepointCallback *_rootScanCallback; /**< Asks mutator threads to scan their own roots at their next safepoint */
 	MM_ConcurrentGCStats _stats;
 
 
@@ -376,6 +377,7 @@ protected:
 	uintptr_t doConcurrentInitialization(MM_EnvironmentBase *env, uintptr_t initToDo);
 	uintptr_t doConcurrentTrace(MM_EnvironmentBase *env, MM_AllocateDescription *allocDescription, uintptr_t sizeToTrace, MM_MemorySubSpace *subspace, bool tlhAllocation);
 	void signalThreadsToActivateWriteBarrier(MM_EnvironmentBase *env);
+	void signalThreadsToScanRoots(MM_EnvironmentBase *env);
 	void resumeConHelperThreads(MM_EnvironmentBase *env);
 	uintptr_t calculateInitSize(MM_EnvironmentBase *env, uintptr_t allocationSize);
 	uintptr_t calculateTraceSize(MM_EnvironmentBase *env, MM_AllocateDescription *allocDescription);
@@ -395,6 +397,7 @@ public:
 	virtual void abortCollection(MM_EnvironmentBase *env, CollectionAbortReason reason);
 	
 	static void signalThreadsToActivateWriteBarrierAsyncEventHandler(OMR_VMThread *omrVMThread, void *userData);
+	static void scanThreadRootsAsyncEventHandler(OMR_VMThread *omrVMThread, void *userData);
 	
 	virtual void prepareHeapForWalk(MM_EnvironmentBase *env);
 
@@ -527,6 +530,7 @@ public:
 		,_rebuildInitWorkForAdd(false)
 		,_retuneAfterHeapResize(false)
 		,_callback(NULL)
+		,_rootScanCallback(NULL)
 		,_stats()
 		{
 			_typeId = __FUNCTION__;
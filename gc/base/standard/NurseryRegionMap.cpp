@@ -0,0 +1,112 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "omrcfg.h"
+
+#include "NurseryRegionMap.hpp"
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+
+#include <string.h>
+
+#include "EnvironmentBase.hpp"
+#include "Forge.hpp"
+
+MM_NurseryRegionMap *
+MM_NurseryRegionMap::newInstance(MM_EnvironmentBase *env, void *heapBase, void *heapTop, uintptr_t regionShift)
+{
+	MM_NurseryRegionMap *map = (MM_NurseryRegionMap *)env->getForge()->allocate(sizeof(MM_NurseryRegionMap), OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL != map) {
+		new(map) MM_NurseryRegionMap();
+		if (!map->initialize(env, heapBase, heapTop, regionShift)) {
+			map->kill(env);
+			map = NULL;
+		}
+	}
+	return map;
+}
+
+bool
+MM_NurseryRegionMap::initialize(MM_EnvironmentBase *env, void *heapBase, void *heapTop, uintptr_t regionShift)
+{
+	_heapBase = (uintptr_t)heapBase;
+	_heapSize = (uintptr_t)heapTop - (uintptr_t)heapBase;
+	_regionShift = regionShift;
+
+	uintptr_t regionCount = (_heapSize + ((uintptr_t)1 << _regionShift) - 1) >> _regionShift;
+	_wordCount = (regionCount + J9BITS_BITS_IN_SLOT - 1) / J9BITS_BITS_IN_SLOT;
+	if (0 == _wordCount) {
+		return false;
+	}
+
+	_bits = (uintptr_t *)env->getForge()->allocate(_wordCount * sizeof(uintptr_t), OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL == _bits) {
+		return false;
+	}
+	clear();
+
+	return true;
+}
+
+void
+MM_NurseryRegionMap::kill(MM_EnvironmentBase *env)
+{
+	tearDown(env);
+	env->getForge()->free(this);
+}
+
+void
+MM_NurseryRegionMap::tearDown(MM_EnvironmentBase *env)
+{
+	if (NULL != _bits) {
+		env->getForge()->free(_bits);
+		_bits = NULL;
+	}
+}
+
+void
+MM_NurseryRegionMap::clear()
+{
+	memset(_bits, 0, _wordCount * sizeof(uintptr_t));
+}
+
+void
+MM_NurseryRegionMap::setRange(void *base, void *top, bool inNursery)
+{
+	uintptr_t low = OMR_MAX((uintptr_t)base, _heapBase);
+	uintptr_t high = OMR_MIN((uintptr_t)top, _heapBase + _heapSize);
+	if (low >= high) {
+		return;
+	}
+
+	uintptr_t index = (low - _heapBase) >> _regionShift;
+	uintptr_t topIndex = ((high - 1 - _heapBase) >> _regionShift) + 1;
+	for (; index < topIndex; index++) {
+		uintptr_t mask = (uintptr_t)1 << (index % J9BITS_BITS_IN_SLOT);
+		if (inNursery) {
+			_bits[index / J9BITS_BITS_IN_SLOT] |= mask;
+		} else {
+			_bits[index / J9BITS_BITS_IN_SLOT] &= ~mask;
+		}
+	}
+}
+
+#endif /* OMR_GC_MODRON_SCAVENGER */
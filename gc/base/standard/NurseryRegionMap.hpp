@@ -0,0 +1,106 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(NURSERYREGIONMAP_HPP_)
+#define NURSERYREGIONMAP_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+
+#if defined(OMR_GC_MODRON_SCAVENGER)
+
+#include "BaseVirtual.hpp"
+#include "Bits.hpp"
+
+class MM_EnvironmentBase;
+
+/**
+ * One bit per heap region recording whether the region belongs to the nursery.
+ * Lets the generational write barrier and the scavenger answer "is this address in the nursery"
+ * with a shift and a bit test, however the nursery is split across the heap.
+ * Ranges are widened to whole regions, so a region only partly in the nursery reports true.
+ * @ingroup GC_Modron_Standard
+ */
+class MM_NurseryRegionMap : public MM_BaseVirtual
+{
+	/*
+	 * Data members
+	 */
+public:
+protected:
+private:
+	uintptr_t *_bits; /**< one bit per region, set when the region is in the nursery */
+	uintptr_t _heapBase; /**< lowest address covered by the map */
+	uintptr_t _heapSize; /**< number of bytes covered by the map */
+	uintptr_t _regionShift; /**< log2 of the region size */
+	uintptr_t _wordCount; /**< number of words in _bits */
+
+	/*
+	 * Function members
+	 */
+public:
+	static MM_NurseryRegionMap *newInstance(MM_EnvironmentBase *env, void *heapBase, void *heapTop, uintptr_t regionShift);
+	void kill(MM_EnvironmentBase *env);
+
+	/**
+	 * Mark every region overlapping [base, top) as being in the nursery or not.
+	 */
+	void setRange(void *base, void *top, bool inNursery);
+
+	/**
+	 * Mark every region as not being in the nursery.
+	 */
+	void clear();
+
+	/**
+	 * @return true if the region containing address is in the nursery; false for addresses outside the heap (including NULL)
+	 */
+	MMINLINE bool
+	isInNursery(const void *address) const
+	{
+		uintptr_t heapDelta = (uintptr_t)address - _heapBase;
+		if (heapDelta >= _heapSize) {
+			return false;
+		}
+		uintptr_t index = heapDelta >> _regionShift;
+		return 0 != (_bits[index / J9BITS_BITS_IN_SLOT] & ((uintptr_t)1 << (index % J9BITS_BITS_IN_SLOT)));
+	}
+
+	MM_NurseryRegionMap()
+		: MM_BaseVirtual()
+		, _bits(NULL)
+		, _heapBase(0)
+		, _heapSize(0)
+		, _regionShift(0)
+		, _wordCount(0)
+	{
+		_typeId = __FUNCTION__;
+	}
+
+protected:
+	bool initialize(MM_EnvironmentBase *env, void *heapBase, void *heapTop, uintptr_t regionShift);
+	void tearDown(MM_EnvironmentBase *env);
+private:
+};
+
+#endif /* OMR_GC_MODRON_SCAVENGER */
+
+#endif /* NURSERYREGIONMAP_HPP_ */
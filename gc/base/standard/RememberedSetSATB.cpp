@@ -26,6 +26,8 @@
 #if defined(OMR_GC_REALTIME)
 
 #include "Debug.hpp"
+#include "EnvironmentBase.hpp"
+#include "GCExtensionsBase.hpp"
 #include "RememberedSetSATB.hpp"
 #include "WorkPackets.hpp"
 
@@ -44,7 +46,7 @@ MM_RememberedSetSATB::newInstance(MM_EnvironmentBase *env, MM_WorkPacketsSATB *w
 {
 	MM_RememberedSetSATB *rememberedSet;
 	
-	rememberedSet = (MM_RememberedSetSATB *)env->getForge()->allocate(sizeof(MM_RememberedSetSATB), MM_AllocationCategory::WORK_PACKETS, J9_GET_CALLSITE());
+	rememberedSet = (MM_RememberedSetSATB *)env->getForge()->allocate(sizeof(MM_RememberedSetSATB), MM_AllocationCategory::WORK_PACKETS, OMR_GET_CALLSITE());
 	if (NULL != rememberedSet) {
 		new(rememberedSet) MM_RememberedSetSATB(env, workPackets);
 		if (!rememberedSet->initialize(env)) {
@@ -116,7 +118,19 @@ void
 MM_RememberedSetSATB::storeInFragment(MM_EnvironmentBase* env, MM_GCRememberedSetFragment* fragment, UDATA* value)
 {
 	if (!isFragmentValid(env, fragment)) {
-		if (!refreshFragment(env, fragment)) {
+		MM_SATBBarrierStats *barrierStats = &env->_sATBBarrierStats;
+		bool refreshed = false;
+		barrierStats->_slowPathCount += 1;
+		if (env->getExtensions()->debugConcurrentMark) {
+			OMRPORT_ACCESS_FROM_ENVIRONMENT(env);
+			uint64_t slowPathStartTime = omrtime_hires_clock();
+			refreshed = refreshFragment(env, fragment);
+			barrierStats->addToSlowPathTime(slowPathStartTime, omrtime_hires_clock());
+		} else {
+			refreshed = refreshFragment(env, fragment);
+		}
+		if (!refreshed) {
+			barrierStats->_overflowCount += 1;
 			_workPackets->overflowItem(env, (void *)value, OVERFLOW_TYPE_BARRIER);
 			return;
 		}
@@ -280,8 +294,9 @@ MM_RememberedSetSATB::refreshFragment(MM_EnvironmentBase *env, MM_GCRememberedSe
 	MM_Packet *oldPacket = (MM_Packet *)fragment->fragmentStorage;
 		
 	if ((NULL != oldPacket) && (getLocalFragmentIndex(env, fragment) == getGlobalFragmentIndex(env)) && (*fragment->fragmentTop == *fragment->fragmentAlloc)) {
+		/* hand the full packet over to the marking threads without taking a shared list lock */
 		_workPackets->removePacketFromInUseList(env, oldPacket);
-		_workPackets->putFullPacket(env, oldPacket);
+		_workPackets->publishBarrierPacket(env, oldPacket);
 	}
 	
 	if (J9GC_REMEMBERED_SET_RESERVED_INDEX == fragment->localFragmentIndex) {
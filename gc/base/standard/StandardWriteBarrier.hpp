@@ -28,12 +28,47 @@
 #include "CardTable.hpp"
 #include "EnvironmentStandard.hpp"
 #include "GCExtensionsBase.hpp"
+#include "NurseryRegionMap.hpp"
 #include "ObjectModel.hpp"
 #include "Scavenger.hpp"
 #include "SlotObject.hpp"
 
 struct OMR_VMThread;
 
+#if defined(OMR_GC_MODRON_SCAVENGER)
+/**
+ * Determine whether an object lies in the nursery using the per-region nursery map, without any
+ * subspace lookup. Falls back to the tenure range check before the nursery has been created.
+ *
+ * @param extensions The GC extensions
+ * @param object The object to test (may be NULL)
+ * @return true if the object is in a nursery region, false otherwise (including NULL)
+ */
+MMINLINE bool
+standardIsObjectInNursery(MM_GCExtensionsBase *extensions, omrobjectptr_t object)
+{
+	MM_NurseryRegionMap *nurseryRegionMap = extensions->nurseryRegionMap;
+	if (NULL != nurseryRegionMap) {
+		return nurseryRegionMap->isInNursery(object);
+	}
+	return (NULL != object) && !extensions->isOld(object);
+}
+
+/**
+ * Generational barrier fast path: does storing childObject into parentObject create an old-to-nursery reference?
+ *
+ * @param extensions The GC extensions
+ * @param parentObject the parent object
+ * @param childObject the child object reference (may be NULL)
+ * @return true if the parent must be remembered
+ */
+MMINLINE bool
+standardIsOldToNurseryStore(MM_GCExtensionsBase *extensions, omrobjectptr_t parentObject, omrobjectptr_t childObject)
+{
+	return extensions->isOld(parentObject) && standardIsObjectInNursery(extensions, childObject);
+}
+#endif /* defined(OMR_GC_MODRON_SCAVENGER) */
+
 /**
  * Out-of-line write barrier. In the absence of other (equivalent inline) write barrier, this method must
  * be called whenever a child reference is assigned to a parent slot.
@@ -53,7 +88,7 @@ standardWriteBarrier(OMR_VMThread *omrThread, omrobjectptr_t parentObject, omrob
 	MM_GCExtensionsBase *extensions = env->getExtensions();
 #if defined(OMR_GC_MODRON_SCAVENGER)
 	if (extensions->scavengerEnabled) {
-		if (extensions->isOld(parentObject) && !extensions->isOld(childObject)) {
+		if (standardIsOldToNurseryStore(extensions, parentObject, childObject)) {
 			if (extensions->objectModel.atomicSetRememberedState(parentObject, STATE_REMEMBERED)) {
 				/* The object has been successfully marked as REMEMBERED - allocate an entry in the remembered set */
 				extensions->scavenger->addToRememberedSetFragment((MM_EnvironmentStandard *)env, parentObject);
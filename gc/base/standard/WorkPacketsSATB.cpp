@@ -26,8 +26,10 @@
 
 #include "WorkPacketsSATB.hpp"
 
+#include "AtomicOperations.hpp"
 #include "Debug.hpp"
 #include "GCExtensionsBase.hpp"
+#include "OMRVMThreadListIterator.hpp"
 #include "OverflowStandard.hpp"
 
 /**
@@ -40,7 +42,7 @@ MM_WorkPacketsSATB::newInstance(MM_EnvironmentBase *env)
 {
 	MM_WorkPacketsSATB *workPackets;
 	
-	workPackets = (MM_WorkPacketsSATB *)env->getForge()->allocate(sizeof(MM_WorkPacketsSATB), MM_AllocationCategory::WORK_PACKETS, J9_GET_CALLSITE());
+	workPackets = (MM_WorkPacketsSATB *)env->getForge()->allocate(sizeof(MM_WorkPacketsSATB), MM_AllocationCategory::WORK_PACKETS, OMR_GET_CALLSITE());
 	if (workPackets) {
 		new(workPackets) MM_WorkPacketsSATB(env);
 		if (!workPackets->initialize(env)) {
@@ -169,6 +171,104 @@ MM_WorkPacketsSATB::putFullPacket(MM_EnvironmentBase *env, MM_Packet *packet)
 	_fullPacketList.push(env, packet);
 }
 
+/**
+ * Publish a full barrier packet to the completed barrier packet stack.
+ * The packet must already have been removed from the inUseBarrierPacket list.
+ * Publishing never blocks: packets are pushed with a compare and swap and only ever
+ * removed all at once by drainCompletedBarrierPackets(), so the push is not exposed to ABA.
+ * @param packet the full packet to publish
+ */
+void
+MM_WorkPacketsSATB::publishBarrierPacket(MM_EnvironmentBase *env, MM_Packet *packet)
+{
+	MM_SATBBarrierStats *barrierStats = &env->_sATBBarrierStats;
+	barrierStats->addRetiredBuffer(packet->usedSlots(), packet->usedSlots() + packet->freeSlots());
+	barrierStats->_buffersPublished += 1;
+
+	MM_Packet *oldHead = NULL;
+	do {
+		oldHead = _completedBarrierPackets;
+		packet->_next = oldHead;
+	} while ((uintptr_t)oldHead != MM_AtomicOperations::lockCompareExchange((volatile uintptr_t *)&_completedBarrierPackets, (uintptr_t)oldHead, (uintptr_t)packet));
+}
+
+/**
+ * Detach every packet from the completed barrier packet stack and make them available
+ * to marking threads as full packets, taking the full packet list lock once per batch.
+ * @return the number of packets drained
+ */
+uintptr_t
+MM_WorkPacketsSATB::drainCompletedBarrierPackets(MM_EnvironmentBase *env)
+{
+	uintptr_t count = 0;
+
+	if (NULL != _completedBarrierPackets) {
+		MM_Packet *head = NULL;
+		do {
+			head = _completedBarrierPackets;
+		} while ((NULL != head) && ((uintptr_t)head != MM_AtomicOperations::lockCompareExchange((volatile uintptr_t *)&_completedBarrierPackets, (uintptr_t)head, (uintptr_t)NULL)));
+
+		if (NULL != head) {
+			MM_Packet *tail = head;
+			MM_Packet *previous = NULL;
+			count = 1;
+			while (NULL != tail->_next) {
+				tail->_previous = previous;
+				previous = tail;
+				tail = tail->_next;
+				count += 1;
+			}
+			tail->_previous = previous;
+
+			_fullPacketList.pushList(head, tail, count);
+			notifyWaitingThreads(env);
+
+			env->_sATBBarrierStats._buffersDrained += count;
+			env->_sATBBarrierStats._drainCount += 1;
+		}
+	}
+
+	return count;
+}
+
+/**
+ * Get an input packet if one is available, picking up any barrier packets published by mutators first.
+ * @return pointer to a packet, or NULL if none available
+ */
+MM_Packet *
+MM_WorkPacketsSATB::getInputPacketNoWait(MM_EnvironmentBase *env)
+{
+	drainCompletedBarrierPackets(env);
+	return MM_WorkPackets::getInputPacketNoWait(env);
+}
+
+/**
+ * Determine whether an input packet is available, including barrier packets
+ * published by mutators that have not been drained yet.
+ * @return true if yes, false if no
+ */
+bool
+MM_WorkPacketsSATB::inputPacketAvailable(MM_EnvironmentBase *env)
+{
+	return completedBarrierPacketsAvailable(env) || MM_WorkPackets::inputPacketAvailable(env);
+}
+
+/**
+ * Merge the thread local barrier statistics of every thread into the statistics for the cycle.
+ * Must be called with exclusive VM access so that no mutator is updating its statistics.
+ */
+void
+MM_WorkPacketsSATB::mergeBarrierStats(MM_EnvironmentBase *env)
+{
+	OMR_VMThread *omrVMThread = NULL;
+	GC_OMRVMThreadListIterator threadListIterator(env->getOmrVM());
+	while (NULL != (omrVMThread = threadListIterator.nextOMRVMThread())) {
+		MM_SATBBarrierStats *threadStats = &MM_EnvironmentBase::getEnvironment(omrVMThread)->_sATBBarrierStats;
+		_barrierStats.merge(threadStats);
+		threadStats->clear();
+	}
+}
+
 /**
  * Move all of the packets from the inUse list to the processing list
  * so they are available for processing.
@@ -180,10 +280,18 @@ MM_WorkPacketsSATB::moveInUseToNonEmpty(MM_EnvironmentBase *env)
 	UDATA count;
 	bool didPop;
 
+	/* pick up any full packets that have not been drained yet */
+	drainCompletedBarrierPackets(env);
+
 	/* pop the inUseList */
 	didPop = _inUseBarrierPacketList.popList(&head, &tail, &count);
 	/* push the values from the inUseList onto the processingList */
 	if (didPop) {
+		MM_Packet *packet = head;
+		for (UDATA i = 0; i < count; i++) {
+			env->_sATBBarrierStats.addRetiredBuffer(packet->usedSlots(), packet->usedSlots() + packet->freeSlots());
+			packet = packet->_next;
+		}
 		_nonEmptyPacketList.pushList(head, tail, count);
 	}
 }
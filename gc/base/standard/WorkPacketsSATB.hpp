@@ -27,6 +27,7 @@
 #if defined(OMR_GC_REALTIME)
 
 #include "EnvironmentBase.hpp"
+#include "SATBBarrierStats.hpp"
 #include "WorkPackets.hpp"
 
 class MM_IncrementalOverflow;
@@ -35,6 +36,8 @@ class MM_WorkPacketsSATB : public MM_WorkPackets
 {
 protected:
 	MM_PacketList _inUseBarrierPacketList;  /**< List for packets currently being used for the remembered set*/
+	MM_Packet * volatile _completedBarrierPackets; /**< Lock-free stack of full barrier packets published by mutators and not yet drained */
+	MM_SATBBarrierStats _barrierStats; /**< Barrier buffer statistics for the current cycle, merged from the thread local copies */
 
 public:
 	static MM_WorkPacketsSATB *newInstance(MM_EnvironmentBase *env);
@@ -51,6 +54,19 @@ public:
 	virtual void putInUsePacket(MM_EnvironmentBase *env, MM_Packet *packet);
 	virtual void removePacketFromInUseList(MM_EnvironmentBase *env, MM_Packet *packet);
 	virtual void putFullPacket(MM_EnvironmentBase *env, MM_Packet *packet);
+	virtual MM_Packet *getInputPacketNoWait(MM_EnvironmentBase *env);
+	virtual bool inputPacketAvailable(MM_EnvironmentBase *env);
+
+	void publishBarrierPacket(MM_EnvironmentBase *env, MM_Packet *packet);
+	uintptr_t drainCompletedBarrierPackets(MM_EnvironmentBase *env);
+	void mergeBarrierStats(MM_EnvironmentBase *env);
+
+	/**
+	 * Returns TRUE if full barrier packets have been published and not yet handed over to marking threads.
+	 */
+	MMINLINE bool completedBarrierPacketsAvailable(MM_EnvironmentBase *env) { return NULL != _completedBarrierPackets; }
+
+	MMINLINE MM_SATBBarrierStats *getBarrierStats() { return &_barrierStats; }
 
 	void moveInUseToNonEmpty(MM_EnvironmentBase *env);
 
@@ -60,6 +76,8 @@ public:
 	MM_WorkPacketsSATB(MM_EnvironmentBase *env) :
 		MM_WorkPackets(env)
 		, _inUseBarrierPacketList(NULL)
+		, _completedBarrierPackets(NULL)
+		, _barrierStats()
 	{
 		_typeId = __FUNCTION__;
 	};
@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(REGIONEVACUATIONTASK_HPP_)
+#define REGIONEVACUATIONTASK_HPP_
+
+#include "omrcfg.h"
+#include "omrmodroncore.h"
+
+#if defined(OMR_GC_VLHGC)
+
+#include "ParallelTask.hpp"
+
+class MM_Dispatcher;
+class MM_EnvironmentBase;
+class MM_MarkMap;
+class MM_RegionEvacuator;
+
+/**
+ * Parallel task copying the live objects of the evacuation set selected by a MM_RegionEvacuator.
+ * @ingroup GC_Base
+ */
+class MM_RegionEvacuationTask : public MM_ParallelTask
+{
+private:
+	MM_RegionEvacuator *_evacuator;
+	MM_MarkMap *_markMap;
+
+public:
+	virtual uintptr_t getVMStateID() { return OMRVMSTATE_GC_REGION_EVACUATE; }
+
+	virtual void run(MM_EnvironmentBase *env);
+
+	/**
+	 * Create a RegionEvacuationTask object.
+	 */
+	MM_RegionEvacuationTask(MM_EnvironmentBase *env, MM_Dispatcher *dispatcher, MM_RegionEvacuator *evacuator, MM_MarkMap *markMap) :
+		MM_ParallelTask(env, dispatcher),
+		_evacuator(evacuator),
+		_markMap(markMap)
+	{
+		_typeId = __FUNCTION__;
+	};
+};
+
+#endif /* defined(OMR_GC_VLHGC) */
+
+#endif /* REGIONEVACUATIONTASK_HPP_ */
@@ -0,0 +1,423 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "omrcfg.h"
+
+#if defined(OMR_GC_VLHGC)
+
+#include "RegionEvacuator.hpp"
+
+#include "AllocateDescription.hpp"
+#include "AtomicOperations.hpp"
+#include "EnvironmentBase.hpp"
+#include "Forge.hpp"
+#include "GlobalCollector.hpp"
+#include "GCExtensionsBase.hpp"
+#include "HeapLinkedFreeHeader.hpp"
+#include "HeapMapIterator.hpp"
+#include "HeapRegionDescriptor.hpp"
+#include "HeapRegionManagerTarok.hpp"
+#include "MarkMap.hpp"
+#include "MemorySubSpace.hpp"
+#include "ModronAssertions.h"
+
+#include <string.h>
+
+/**
+ * Helper function used by J9_SORT to order candidates by ascending live bytes.
+ */
+static int
+compareCandidateLiveBytesFunc(const void *element1, const void *element2)
+{
+	MM_RegionEvacuator::Candidate *candidate1 = (MM_RegionEvacuator::Candidate *)element1;
+	MM_RegionEvacuator::Candidate *candidate2 = (MM_RegionEvacuator::Candidate *)element2;
+
+	if (candidate1->_liveBytes == candidate2->_liveBytes) {
+		return 0;
+	} else if (candidate1->_liveBytes > candidate2->_liveBytes) {
+		return 1;
+	} else {
+		return -1;
+	}
+}
+
+MM_RegionEvacuator *
+MM_RegionEvacuator::newInstance(MM_EnvironmentBase *env, MM_HeapRegionManagerTarok *regionManager)
+{
+	MM_RegionEvacuator *evacuator = (MM_RegionEvacuator *)env->getForge()->allocate(sizeof(MM_RegionEvacuator), OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL != evacuator) {
+		new(evacuator) MM_RegionEvacuator(env, regionManager);
+		if (!evacuator->initialize(env)) {
+			evacuator->kill(env);
+			evacuator = NULL;
+		}
+	}
+	return evacuator;
+}
+
+MM_RegionEvacuator::MM_RegionEvacuator(MM_EnvironmentBase *env, MM_HeapRegionManagerTarok *regionManager)
+	: MM_BaseVirtual()
+	, _extensions(env->getExtensions())
+	, _regionManager(regionManager)
+	, _regionStateTable(NULL)
+	, _candidates(NULL)
+	, _candidateCount(0)
+	, _candidateCapacity(0)
+	, _evacuationSetSize(0)
+	, _nextCandidateIndex(0)
+	, _cursors(NULL)
+	, _cursorCount(0)
+	, _bytesCopied(0)
+	, _objectsCopied(0)
+	, _copyChunksAcquired(0)
+	, _regionsReclaimed(0)
+{
+	_typeId = __FUNCTION__;
+}
+
+void
+MM_RegionEvacuator::kill(MM_EnvironmentBase *env)
+{
+	tearDown(env);
+	env->getForge()->free(this);
+}
+
+/**
+ * Allocate the candidate table, the per-thread copy cursors and the region state table.
+ * The region table of the manager must already describe the contiguous heap range.
+ */
+bool
+MM_RegionEvacuator::initialize(MM_EnvironmentBase *env)
+{
+	OMR::GC::Forge *forge = env->getForge();
+
+	_candidateCapacity = _regionManager->getTableRegionCount();
+	if (0 == _candidateCapacity) {
+		return false;
+	}
+
+	_candidates = (Candidate *)forge->allocate(sizeof(Candidate) * _candidateCapacity, OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL == _candidates) {
+		return false;
+	}
+
+	_cursorCount = OMR_MAX(_extensions->gcThreadCount, 1);
+	_cursors = (CopyCursor *)forge->allocate(sizeof(CopyCursor) * _cursorCount, OMR::GC::AllocationCategory::FIXED, OMR_GET_CALLSITE());
+	if (NULL == _cursors) {
+		return false;
+	}
+	memset(_cursors, 0, sizeof(CopyCursor) * _cursorCount);
+
+	uintptr_t heapBase = (uintptr_t)_regionManager->physicalTableDescriptorForIndex(0)->getLowAddress();
+	_regionStateTable = OMR::GC::HeapRegionStateTable::newInstance(forge, heapBase, _regionManager->getRegionShift(), _candidateCapacity);
+	if (NULL == _regionStateTable) {
+		return false;
+	}
+
+	return true;
+}
+
+void
+MM_RegionEvacuator::tearDown(MM_EnvironmentBase *env)
+{
+	OMR::GC::Forge *forge = env->getForge();
+
+	if (NULL != _regionStateTable) {
+		_regionStateTable->kill(forge);
+		_regionStateTable = NULL;
+	}
+	if (NULL != _cursors) {
+		forge->free(_cursors);
+		_cursors = NULL;
+	}
+	if (NULL != _candidates) {
+		forge->free(_candidates);
+		_candidates = NULL;
+	}
+}
+
+uintptr_t
+MM_RegionEvacuator::selectMostGarbageDense(Candidate *candidates, uintptr_t count, uintptr_t maxRegions, uintptr_t maxLiveBytes)
+{
+	J9_SORT(candidates, count, sizeof(Candidate), compareCandidateLiveBytesFunc);
+
+	uintptr_t selected = 0;
+	while ((selected < count) && (selected < maxRegions) && (candidates[selected]._liveBytes <= maxLiveBytes)) {
+		selected += 1;
+	}
+	return selected;
+}
+
+/**
+ * Sum the consumed size of every marked object in region.
+ */
+uintptr_t
+MM_RegionEvacuator::measureLiveBytes(MM_EnvironmentBase *env, MM_MarkMap *markMap, MM_HeapRegionDescriptor *region)
+{
+	uintptr_t liveBytes = 0;
+	MM_HeapMapIterator markedObjectIterator(_extensions, markMap, (uintptr_t *)region->getLowAddress(), (uintptr_t *)region->getHighAddress());
+	omrobjectptr_t objectPtr = NULL;
+	while (NULL != (objectPtr = markedObjectIterator.nextObject())) {
+		liveBytes += _extensions->objectModel.getConsumedSizeInBytesWithHeader(objectPtr);
+	}
+	return liveBytes;
+}
+
+uintptr_t
+MM_RegionEvacuator::selectEvacuationSet(MM_EnvironmentBase *env, MM_MarkMap *markMap, uintptr_t maxRegions, uintptr_t maxLiveRatio)
+{
+	Assert_MM_true(0 == _evacuationSetSize);
+
+	_candidateCount = 0;
+	MM_HeapRegionDescriptor *region = _regionManager->getFirstTableRegion();
+	while (NULL != region) {
+		/* spanning regions hold a single large object; there is nothing to gain by moving it */
+		if (region->containsObjects() && (1 == region->_regionsInSpan)) {
+			Assert_MM_true(_candidateCount < _candidateCapacity);
+			Candidate *candidate = &_candidates[_candidateCount];
+			candidate->_region = region;
+			candidate->_liveBytes = measureLiveBytes(env, markMap, region);
+			candidate->_evacuated = false;
+			_candidateCount += 1;
+		}
+		region = _regionManager->getNextTableRegion(region);
+	}
+
+	uintptr_t maxLiveBytes = (_regionManager->getRegionSize() / 100) * maxLiveRatio;
+	_evacuationSetSize = selectMostGarbageDense(_candidates, _candidateCount, maxRegions, maxLiveBytes);
+
+	for (uintptr_t i = 0; i < _evacuationSetSize; i++) {
+		_regionStateTable->setRegionState(_candidates[i]._region->getLowAddress(), HEAP_REGION_STATE_EVACUATE);
+	}
+
+	_nextCandidateIndex = 0;
+	_bytesCopied = 0;
+	_objectsCopied = 0;
+	_copyChunksAcquired = 0;
+	_regionsReclaimed = 0;
+
+	return _evacuationSetSize;
+}
+
+void
+MM_RegionEvacuator::evacuate(MM_EnvironmentBase *env, MM_MarkMap *markMap)
+{
+	while (true) {
+		uintptr_t index = MM_AtomicOperations::add(&_nextCandidateIndex, 1) - 1;
+		if (index >= _evacuationSetSize) {
+			break;
+		}
+		Candidate *candidate = &_candidates[index];
+		candidate->_evacuated = evacuateRegion(env, markMap, candidate->_region);
+	}
+}
+
+/**
+ * Copy every marked object of region to the calling thread's copy chunks.
+ * Source regions are claimed by exactly one thread so objects are never raced for.
+ * @return true if every live object was copied, false if destination space ran out
+ */
+bool
+MM_RegionEvacuator::evacuateRegion(MM_EnvironmentBase *env, MM_MarkMap *markMap, MM_HeapRegionDescriptor *region)
+{
+	Assert_MM_true(env->getSlaveID() < _cursorCount);
+	CopyCursor *cursor = &_cursors[env->getSlaveID()];
+	uintptr_t bytesCopied = 0;
+	uintptr_t objectsCopied = 0;
+	bool evacuated = true;
+
+	MM_HeapMapIterator markedObjectIterator(_extensions, markMap, (uintptr_t *)region->getLowAddress(), (uintptr_t *)region->getHighAddress());
+	omrobjectptr_t objectPtr = NULL;
+	while (NULL != (objectPtr = markedObjectIterator.nextObject())) {
+		uintptr_t sizeInBytes = _extensions->objectModel.getConsumedSizeInBytesWithHeader(objectPtr);
+		omrobjectptr_t destinationPtr = (omrobjectptr_t)reserveCopySpace(env, cursor, region, sizeInBytes);
+		if (NULL == destinationPtr) {
+			/* the remaining objects stay where they are and the region is not reclaimed */
+			evacuated = false;
+			break;
+		}
+
+		memcpy((void *)destinationPtr, (void *)objectPtr, sizeInBytes);
+		MM_ForwardedHeader forwardedHeader(objectPtr);
+		forwardedHeader.setForwardedObject(destinationPtr);
+		markMap->atomicSetBit(destinationPtr);
+
+		bytesCopied += sizeInBytes;
+		objectsCopied += 1;
+	}
+
+	MM_AtomicOperations::add(&_bytesCopied, bytesCopied);
+	MM_AtomicOperations::add(&_objectsCopied, objectsCopied);
+
+	return evacuated;
+}
+
+/**
+ * Bump allocate sizeInBytes from the thread's copy cursor. When the cursor is exhausted a new chunk
+ * is allocated from the subspace of the source region, the same way copying collectors get their
+ * copy caches, so the memory pool keeps track of where the copies live.
+ * @return the reserved address or NULL if the subspace has no room left
+ */
+void *
+MM_RegionEvacuator::reserveCopySpace(MM_EnvironmentBase *env, CopyCursor *cursor, MM_HeapRegionDescriptor *sourceRegion, uintptr_t sizeInBytes)
+{
+	if ((sourceRegion->getSubSpace() != cursor->_subSpace) || (((uintptr_t)cursor->_top - (uintptr_t)cursor->_alloc) < sizeInBytes)) {
+		retireCopyCursor(env, cursor);
+
+		MM_MemorySubSpace *subSpace = sourceRegion->getSubSpace();
+		void *addrBase = NULL;
+		void *addrTop = NULL;
+		if (!allocateCopyChunk(env, subSpace, sizeInBytes, addrBase, addrTop)) {
+			return NULL;
+		}
+		MM_AtomicOperations::add(&_copyChunksAcquired, 1);
+
+		cursor->_subSpace = subSpace;
+		cursor->_alloc = addrBase;
+		cursor->_top = addrTop;
+	}
+
+	void *result = cursor->_alloc;
+	cursor->_alloc = (void *)((uintptr_t)cursor->_alloc + sizeInBytes);
+	return result;
+}
+
+/**
+ * Allocate a chunk of at least minimumSize bytes from subSpace which does not overlap the evacuation set.
+ * Free memory inside regions being evacuated is useless as a destination: such chunks are kept out of the
+ * pool as holes, they will be recovered together with the rest of the region.
+ * @return true if [addrBase, addrTop) has been allocated
+ */
+bool
+MM_RegionEvacuator::allocateCopyChunk(MM_EnvironmentBase *env, MM_MemorySubSpace *subSpace, uintptr_t minimumSize, void * &addrBase, void * &addrTop)
+{
+	MM_Collector *collector = _extensions->getGlobalCollector();
+
+#if defined(OMR_GC_THREAD_LOCAL_HEAP)
+	while (true) {
+		MM_AllocateDescription chunkDescription(0, 0, false, true);
+		if (NULL == subSpace->collectorAllocateTLH(env, collector, &chunkDescription, _regionManager->getRegionSize(), addrBase, addrTop)) {
+			break;
+		}
+		if (!overlapsEvacuationSet(addrBase, addrTop)) {
+			if (((uintptr_t)addrTop - (uintptr_t)addrBase) >= minimumSize) {
+				return true;
+			}
+			/* too small for this object: leave it walkable and ask for the object on its own */
+			subSpace->abandonHeapChunk(addrBase, addrTop);
+			break;
+		}
+		MM_HeapLinkedFreeHeader::fillWithHoles(addrBase, (uintptr_t)addrTop - (uintptr_t)addrBase);
+	}
+#endif /* defined(OMR_GC_THREAD_LOCAL_HEAP) */
+
+	while (true) {
+		MM_AllocateDescription objectDescription(minimumSize, 0, false, true);
+		addrBase = subSpace->collectorAllocate(env, collector, &objectDescription);
+		if (NULL == addrBase) {
+			break;
+		}
+		addrTop = (void *)((uintptr_t)addrBase + minimumSize);
+		if (!overlapsEvacuationSet(addrBase, addrTop)) {
+			return true;
+		}
+		MM_HeapLinkedFreeHeader::fillWithHoles(addrBase, minimumSize);
+	}
+
+	addrBase = NULL;
+	addrTop = NULL;
+	return false;
+}
+
+/**
+ * @return true if any region spanned by [addrBase, addrTop) is in the evacuation set
+ */
+bool
+MM_RegionEvacuator::overlapsEvacuationSet(void *addrBase, void *addrTop)
+{
+	uintptr_t regionSize = _regionManager->getRegionSize();
+	uintptr_t address = (uintptr_t)addrBase;
+	while (address < (uintptr_t)addrTop) {
+		if (isInEvacuationSet((void *)address)) {
+			return true;
+		}
+		address = (address & ~(regionSize - 1)) + regionSize;
+	}
+	return false;
+}
+
+/**
+ * Leave the unused tail of the cursor's chunk walkable, the next sweep of its memory pool recovers it.
+ */
+void
+MM_RegionEvacuator::retireCopyCursor(MM_EnvironmentBase *env, CopyCursor *cursor)
+{
+	if (NULL != cursor->_subSpace) {
+		if (cursor->_alloc < cursor->_top) {
+			cursor->_subSpace->abandonHeapChunk(cursor->_alloc, cursor->_top);
+		}
+		cursor->_subSpace = NULL;
+		cursor->_alloc = NULL;
+		cursor->_top = NULL;
+	}
+}
+
+void
+MM_RegionEvacuator::flushCopyCursor(MM_EnvironmentBase *env)
+{
+	Assert_MM_true(env->getSlaveID() < _cursorCount);
+	retireCopyCursor(env, &_cursors[env->getSlaveID()]);
+}
+
+uintptr_t
+MM_RegionEvacuator::reclaimEvacuatedRegions(MM_EnvironmentBase *env, MM_MarkMap *markMap)
+{
+	uintptr_t reclaimed = 0;
+
+	for (uintptr_t i = 0; i < _evacuationSetSize; i++) {
+		Candidate *candidate = &_candidates[i];
+		MM_HeapRegionDescriptor *region = candidate->_region;
+
+		_regionStateTable->setRegionState(region->getLowAddress(), HEAP_REGION_STATE_NONE);
+		if (candidate->_evacuated) {
+			/* nothing in the region is live any more: the sweep turns it into a single free entry of its pool */
+			markMap->setBitsInRange(env, region->getLowAddress(), region->getHighAddress(), true);
+			reclaimed += 1;
+		} else {
+			/* Partially evacuated: the originals of copied objects are now dead, unmark them so the sweep frees them */
+			MM_HeapMapIterator markedObjectIterator(_extensions, markMap, (uintptr_t *)region->getLowAddress(), (uintptr_t *)region->getHighAddress(), false);
+			omrobjectptr_t objectPtr = NULL;
+			while (NULL != (objectPtr = markedObjectIterator.nextObject())) {
+				MM_ForwardedHeader forwardedHeader(objectPtr);
+				if (forwardedHeader.isForwardedPointer()) {
+					markMap->clearBit(objectPtr);
+				}
+			}
+		}
+	}
+
+	_evacuationSetSize = 0;
+	_regionsReclaimed = reclaimed;
+	return reclaimed;
+}
+
+#endif /* defined(OMR_GC_VLHGC) */
@@ -0,0 +1,210 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(REGIONEVACUATOR_HPP_)
+#define REGIONEVACUATOR_HPP_
+
+#include "omrcfg.h"
+#include "omrgcconsts.h"
+
+#if defined(OMR_GC_VLHGC)
+
+#include "BaseVirtual.hpp"
+#include "ForwardedHeader.hpp"
+#include "HeapRegionStateTable.hpp"
+#include "SlotObject.hpp"
+
+class MM_EnvironmentBase;
+class MM_GCExtensionsBase;
+class MM_HeapRegionDescriptor;
+class MM_HeapRegionManagerTarok;
+class MM_MarkMap;
+class MM_MemorySubSpace;
+
+/**
+ * Partial, region-based evacuation built on the table regions of MM_HeapRegionManagerTarok.
+ *
+ * After a mark, selectEvacuationSet() measures the live bytes of every region that holds objects
+ * and picks the most garbage-dense ones. evacuate() is then run by every thread of a
+ * MM_RegionEvacuationTask: threads claim whole source regions, copy their marked objects into
+ * chunks allocated from the subspace of the source region and leave forwarding pointers behind.
+ * Once references have been updated through getForwardedObject()/fixupSlot(),
+ * reclaimEvacuatedRegions() unmarks everything left in the evacuation set, so the following sweep
+ * returns each fully evacuated region to its pool as a single free entry, where it is available
+ * for contraction back to the region manager. Fragmentation is bounded by the size of the
+ * evacuation set instead of requiring a full compact.
+ *
+ * This is the building block only: the collector that owns the Tarok heap decides when to
+ * evacuate, dispatches the task and walks its roots and objects to fix up references.
+ *
+ * Membership in the evacuation set is recorded in a OMR::GC::HeapRegionStateTable so that
+ * isInEvacuationSet() is a single table lookup.
+ * @ingroup GC_Base
+ */
+class MM_RegionEvacuator : public MM_BaseVirtual
+{
+	/*
+	 * Data members
+	 */
+public:
+	/**
+	 * A region considered for evacuation and the number of live bytes it contains.
+	 */
+	struct Candidate {
+		MM_HeapRegionDescriptor *_region; /**< The candidate region */
+		uintptr_t _liveBytes; /**< Bytes consumed by marked objects in the region */
+		bool _evacuated; /**< True once every live object of the region has been copied out */
+	};
+
+private:
+	/**
+	 * Per-thread destination for copied objects.
+	 */
+	struct CopyCursor {
+		MM_MemorySubSpace *_subSpace; /**< Subspace the current chunk was allocated from, or NULL if there is no chunk */
+		void *_alloc; /**< Next free byte in the current chunk */
+		void *_top; /**< End of the current chunk */
+	};
+
+	MM_GCExtensionsBase *_extensions;
+	MM_HeapRegionManagerTarok *_regionManager;
+	OMR::GC::HeapRegionStateTable *_regionStateTable; /**< Marks regions selected for evacuation */
+	Candidate *_candidates; /**< Candidate regions, sorted so the evacuation set comes first */
+	uintptr_t _candidateCount; /**< Number of valid entries in _candidates */
+	uintptr_t _candidateCapacity; /**< Number of entries allocated in _candidates (one per table region) */
+	uintptr_t _evacuationSetSize; /**< Number of leading entries of _candidates selected for evacuation */
+	volatile uintptr_t _nextCandidateIndex; /**< Next evacuation set entry to be claimed by a worker thread */
+	CopyCursor *_cursors; /**< One copy cursor per GC thread, indexed by slave ID */
+	uintptr_t _cursorCount; /**< Number of entries in _cursors */
+
+	volatile uintptr_t _bytesCopied; /**< Bytes copied during the last evacuation */
+	volatile uintptr_t _objectsCopied; /**< Objects copied during the last evacuation */
+	volatile uintptr_t _copyChunksAcquired; /**< Copy chunks allocated from subspaces during the last evacuation */
+	uintptr_t _regionsReclaimed; /**< Source regions left without live objects by the last reclaim */
+
+	/*
+	 * Function members
+	 */
+public:
+	static MM_RegionEvacuator *newInstance(MM_EnvironmentBase *env, MM_HeapRegionManagerTarok *regionManager);
+	virtual void kill(MM_EnvironmentBase *env);
+
+	/**
+	 * Order candidates by ascending live bytes and keep those with at most maxLiveBytes live.
+	 * @param candidates the candidates to order
+	 * @param count number of candidates
+	 * @param maxRegions the maximum number of regions to select
+	 * @param maxLiveBytes regions with more live bytes than this are never selected
+	 * @return the number of leading candidates selected
+	 */
+	static uintptr_t selectMostGarbageDense(Candidate *candidates, uintptr_t count, uintptr_t maxRegions, uintptr_t maxLiveBytes);
+
+	/**
+	 * Choose the evacuation set from the regions containing objects, based on the marks in markMap.
+	 * @param markMap a mark map which is valid for the whole heap
+	 * @param maxRegions the maximum number of regions to evacuate
+	 * @param maxLiveRatio regions whose live ratio exceeds this percentage are not worth copying
+	 * @return the number of regions selected
+	 */
+	uintptr_t selectEvacuationSet(MM_EnvironmentBase *env, MM_MarkMap *markMap, uintptr_t maxRegions, uintptr_t maxLiveRatio);
+
+	/**
+	 * Copy the live objects of the evacuation set. Called by every thread participating in the task.
+	 * @param markMap the mark map used to select the evacuation set; copied objects are marked in it
+	 */
+	void evacuate(MM_EnvironmentBase *env, MM_MarkMap *markMap);
+
+	/**
+	 * Flush the calling thread's copy cursor. Called by every thread once evacuate() has returned.
+	 */
+	void flushCopyCursor(MM_EnvironmentBase *env);
+
+	/**
+	 * Clear the marks of every evacuated object in the evacuation set and reset the region state table,
+	 * so that the sweep frees the evacuated memory. Must be called once all references have been fixed up.
+	 * @param markMap the mark map used for the evacuation
+	 * @return the number of regions which no longer contain live objects
+	 */
+	uintptr_t reclaimEvacuatedRegions(MM_EnvironmentBase *env, MM_MarkMap *markMap);
+
+	/**
+	 * @return true if address lies in a region selected for evacuation
+	 */
+	MMINLINE bool
+	isInEvacuationSet(const void *address)
+	{
+		return HEAP_REGION_STATE_EVACUATE == _regionStateTable->getRegionState(address);
+	}
+
+	/**
+	 * @return the new location of objectPtr if it was evacuated, otherwise objectPtr
+	 */
+	MMINLINE omrobjectptr_t
+	getForwardedObject(omrobjectptr_t objectPtr)
+	{
+		if ((NULL != objectPtr) && isInEvacuationSet(objectPtr)) {
+			MM_ForwardedHeader forwardedHeader(objectPtr);
+			omrobjectptr_t forwardedPtr = forwardedHeader.getForwardedObject();
+			if (NULL != forwardedPtr) {
+				return forwardedPtr;
+			}
+		}
+		return objectPtr;
+	}
+
+	/**
+	 * Update a reference slot to point at the new location of an evacuated object.
+	 */
+	MMINLINE void
+	fixupSlot(GC_SlotObject *slotObject)
+	{
+		omrobjectptr_t objectPtr = slotObject->readReferenceFromSlot();
+		omrobjectptr_t forwardedPtr = getForwardedObject(objectPtr);
+		if (forwardedPtr != objectPtr) {
+			slotObject->writeReferenceToSlot(forwardedPtr);
+		}
+	}
+
+	MMINLINE uintptr_t getEvacuationSetSize() const { return _evacuationSetSize; }
+	MMINLINE uintptr_t getBytesCopied() const { return _bytesCopied; }
+	MMINLINE uintptr_t getObjectsCopied() const { return _objectsCopied; }
+	MMINLINE uintptr_t getCopyChunksAcquired() const { return _copyChunksAcquired; }
+	MMINLINE uintptr_t getRegionsReclaimed() const { return _regionsReclaimed; }
+
+	MM_RegionEvacuator(MM_EnvironmentBase *env, MM_HeapRegionManagerTarok *regionManager);
+
+protected:
+	bool initialize(MM_EnvironmentBase *env);
+	void tearDown(MM_EnvironmentBase *env);
+
+private:
+	uintptr_t measureLiveBytes(MM_EnvironmentBase *env, MM_MarkMap *markMap, MM_HeapRegionDescriptor *region);
+	bool evacuateRegion(MM_EnvironmentBase *env, MM_MarkMap *markMap, MM_HeapRegionDescriptor *region);
+	void *reserveCopySpace(MM_EnvironmentBase *env, CopyCursor *cursor, MM_HeapRegionDescriptor *sourceRegion, uintptr_t sizeInBytes);
+	bool allocateCopyChunk(MM_EnvironmentBase *env, MM_MemorySubSpace *subSpace, uintptr_t minimumSize, void * &addrBase, void * &addrTop);
+	bool overlapsEvacuationSet(void *addrBase, void *addrTop);
+	void retireCopyCursor(MM_EnvironmentBase *env, CopyCursor *cursor);
+};
+
+#endif /* defined(OMR_GC_VLHGC) */
+
+#endif /* REGIONEVACUATOR_HPP_ */
@@ -0,0 +1,139 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+/**
+ * @file
+ * @ingroup GC_Stats
+ */
+
+#if !defined(SATBBARRIERSTATS_HPP_)
+#define SATBBARRIERSTATS_HPP_
+
+#include "omrcfg.h"
+#include "omrcomp.h"
+#include "omrport.h"
+#include "modronbase.h"
+
+/**
+ * Statistics for the snapshot at the beginning write barrier buffers.
+ * Mutators update their own thread local copy out of the barrier slow path; the copies are
+ * merged into the collector's copy while exclusive access is held for the final collection.
+ * @ingroup GC_Stats
+ */
+class MM_SATBBarrierStats
+{
+public:
+	uintptr_t _buffersPublished; /**< Number of full barrier buffers published to the completed buffer queue */
+	uintptr_t _buffersDrained; /**< Number of completed barrier buffers handed over to marking threads */
+	uintptr_t _drainCount; /**< Number of times the completed buffer queue was found non-empty and drained */
+	uintptr_t _slotsFilled; /**< Number of barrier entries recorded in buffers that were retired */
+	uintptr_t _slotsCapacity; /**< Total capacity of buffers that were retired */
+	uintptr_t _slowPathCount; /**< Number of times a mutator took the barrier buffer refresh slow path */
+	uint64_t _slowPathTime; /**< Time, in hi-res ticks, mutators spent in the barrier buffer refresh slow path (only measured with debugConcurrentMark) */
+	uintptr_t _overflowCount; /**< Number of barrier entries that could not be buffered and were overflowed */
+
+public:
+	void clear()
+	{
+		_buffersPublished = 0;
+		_buffersDrained = 0;
+		_drainCount = 0;
+		_slotsFilled = 0;
+		_slotsCapacity = 0;
+		_slowPathCount = 0;
+		_slowPathTime = 0;
+		_overflowCount = 0;
+	}
+
+	void merge(MM_SATBBarrierStats *statsToMerge)
+	{
+		_buffersPublished += statsToMerge->_buffersPublished;
+		_buffersDrained += statsToMerge->_buffersDrained;
+		_drainCount += statsToMerge->_drainCount;
+		_slotsFilled += statsToMerge->_slotsFilled;
+		_slotsCapacity += statsToMerge->_slotsCapacity;
+		_slowPathCount += statsToMerge->_slowPathCount;
+		_slowPathTime += statsToMerge->_slowPathTime;
+		_overflowCount += statsToMerge->_overflowCount;
+	}
+
+	/**
+	 * Record a barrier buffer being retired, either because it filled up or because it was
+	 * flushed before the final phase of the collection.
+	 * @param filled number of entries in the buffer
+	 * @param capacity total number of slots in the buffer
+	 */
+	MMINLINE void
+	addRetiredBuffer(uintptr_t filled, uintptr_t capacity)
+	{
+		_slotsFilled += filled;
+		_slotsCapacity += capacity;
+	}
+
+	/**
+	 * Add a time interval to the barrier slow path time.
+	 * Time is stored in raw format, converted to resolution at time of output.
+	 */
+	MMINLINE void
+	addToSlowPathTime(uint64_t startTime, uint64_t endTime)
+	{
+		_slowPathTime += (endTime - startTime);
+	}
+
+	/**
+	 * @return the average fill rate of retired barrier buffers, in percent
+	 */
+	MMINLINE uintptr_t
+	getFillRatePercent()
+	{
+		return (0 == _slotsCapacity) ? 0 : ((_slotsFilled * 100) / _slotsCapacity);
+	}
+
+	MMINLINE void
+	printBarrierReport(OMR_VM *omrVM)
+	{
+		OMRPORT_ACCESS_FROM_OMRVM(omrVM);
+
+		omrtty_printf("SATB barrier analysis: Buffers published: %zu drained: %zu in %zu batches, fill rate: %zu%%, slow paths: %zu (%llu us), overflowed entries: %zu\n",
+						_buffersPublished,
+						_buffersDrained,
+						_drainCount,
+						getFillRatePercent(),
+						_slowPathCount,
+						omrtime_hires_delta(0, _slowPathTime, OMRPORT_TIME_DELTA_IN_MICROSECONDS),
+						_overflowCount
+					);
+	}
+
+	MM_SATBBarrierStats()
+		: _buffersPublished(0)
+		, _buffersDrained(0)
+		, _drainCount(0)
+		, _slotsFilled(0)
+		, _slotsCapacity(0)
+		, _slowPathCount(0)
+		, _slowPathTime(0)
+		, _overflowCount(0)
+	{}
+};
+
+#endif /* SATBBARRIERSTATS_HPP_ */
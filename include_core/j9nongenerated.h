@@ -214,6 +214,8 @@ typedef struct J9MemorySegmentList {
 
 #if defined(OMR_GC_REALTIME)
 
+#define J9GC_REMEMBERED_SET_RESERVED_INDEX  0
+
 typedef struct MM_GCRememberedSet {
 	uintptr_t globalFragmentIndex;
 	uintptr_t preservedGlobalFragmentIndex;
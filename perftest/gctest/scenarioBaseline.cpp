@@ -0,0 +1,347 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "scenarioBaseline.hpp"
+
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+
+/* pauses this much longer than baseline are always tolerated, so short pauses do not flag timer noise */
+#define PAUSE_NOISE_FLOOR_MS 0.5
+
+static const char *XPATH_GET_ALL_PAUSES = "/verbosegc/exclusive-end";
+static const char *XPATH_GET_ALL_EXCLUSIVE_STARTS = "/verbosegc/exclusive-start";
+static const char *XPATH_GET_ALL_ALLOCATION_STATS = "/verbosegc/allocation-stats";
+
+static double
+percentile(const std::vector<double> &sorted, double fraction)
+{
+	if (sorted.empty()) {
+		return 0.0;
+	}
+	/* nearest rank */
+	size_t rank = (size_t)(fraction * sorted.size() + 0.999999);
+	if (0 == rank) {
+		rank = 1;
+	}
+	return sorted[std::min(rank, sorted.size()) - 1];
+}
+
+std::string
+scenarioNameFromLogFile(const char *fileName)
+{
+	std::string name(fileName);
+	for (int i = 0; i < 2; i++) {
+		size_t separator = name.rfind('_');
+		if (std::string::npos == separator) {
+			break;
+		}
+		name.erase(separator);
+	}
+	return name;
+}
+
+void
+collectScenarioResult(pugi::xml_document &doc, const std::string &name, ScenarioResult *result)
+{
+	std::vector<double> pauses;
+	pugi::xpath_node_set pauseNodes = doc.select_nodes(XPATH_GET_ALL_PAUSES);
+	for (pugi::xpath_node_set::const_iterator it = pauseNodes.begin(); it != pauseNodes.end(); ++it) {
+		pauses.push_back(it->node().attribute("durationms").as_double());
+	}
+	std::sort(pauses.begin(), pauses.end());
+
+	/* exclusive-start intervals are measured start to start, beginning at verbose GC initialization */
+	double elapsedMs = 0.0;
+	pugi::xpath_node_set startNodes = doc.select_nodes(XPATH_GET_ALL_EXCLUSIVE_STARTS);
+	for (pugi::xpath_node_set::const_iterator it = startNodes.begin(); it != startNodes.end(); ++it) {
+		elapsedMs += it->node().attribute("intervalms").as_double();
+	}
+	if (!pauseNodes.empty()) {
+		elapsedMs += (pauseNodes.end() - 1)->node().attribute("durationms").as_double();
+	}
+
+	double allocatedBytes = 0.0;
+	pugi::xpath_node_set allocationNodes = doc.select_nodes(XPATH_GET_ALL_ALLOCATION_STATS);
+	for (pugi::xpath_node_set::const_iterator it = allocationNodes.begin(); it != allocationNodes.end(); ++it) {
+		allocatedBytes += it->node().attribute("totalBytes").as_double();
+	}
+
+	result->name = name;
+	result->pauseCount = pauses.size();
+	result->pauseP50Ms = percentile(pauses, 0.50);
+	result->pauseP90Ms = percentile(pauses, 0.90);
+	result->pauseP99Ms = percentile(pauses, 0.99);
+	result->pauseMaxMs = pauses.empty() ? 0.0 : pauses.back();
+	result->totalPauseMs = 0.0;
+	for (size_t i = 0; i < pauses.size(); i++) {
+		result->totalPauseMs += pauses[i];
+	}
+	result->elapsedMs = elapsedMs;
+	result->throughput = (elapsedMs > 0.0) ? (1.0 - (result->totalPauseMs / elapsedMs)) : 1.0;
+	result->allocationRateMBps = (elapsedMs > 0.0) ? ((allocatedBytes / (1024.0 * 1024.0)) / (elapsedMs / 1000.0)) : 0.0;
+}
+
+void
+printScenarioResult(OMRPortLibrary *portLibrary, const ScenarioResult *result)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	omrtty_printf("Scenario %s: %zu pauses over %f ms\n", result->name.c_str(), result->pauseCount, result->elapsedMs);
+	omrtty_printf("  throughput %f, allocation rate %f MB/s\n", result->throughput, result->allocationRateMBps);
+	omrtty_printf("  pause ms    p50 %f    p90 %f    p99 %f    max %f\n\n",
+			result->pauseP50Ms, result->pauseP90Ms, result->pauseP99Ms, result->pauseMaxMs);
+}
+
+bool
+writeScenarioBaseline(OMRPortLibrary *portLibrary, const char *fileName, const ScenarioResultMap &results, double tolerancePercent)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	intptr_t fd = omrfile_open(fileName, EsOpenWrite | EsOpenCreate | EsOpenTruncate, 0644);
+	if (-1 == fd) {
+		omrtty_printf("Failed to open baseline file %s for writing\n", fileName);
+		return false;
+	}
+
+	omrfile_printf(fd, "{\n\t\"tolerancePercent\": %f,\n\t\"scenarios\": {", tolerancePercent);
+	const char *separator = "\n";
+	for (ScenarioResultMap::const_iterator it = results.begin(); it != results.end(); ++it) {
+		const ScenarioResult *result = &it->second;
+		omrfile_printf(fd, "%s\t\t\"%s\": {\n", separator, result->name.c_str());
+		omrfile_printf(fd, "\t\t\t\"throughput\": %f,\n", result->throughput);
+		omrfile_printf(fd, "\t\t\t\"allocationRateMBps\": %f,\n", result->allocationRateMBps);
+		omrfile_printf(fd, "\t\t\t\"pauseP50Ms\": %f,\n", result->pauseP50Ms);
+		omrfile_printf(fd, "\t\t\t\"pauseP90Ms\": %f,\n", result->pauseP90Ms);
+		omrfile_printf(fd, "\t\t\t\"pauseP99Ms\": %f,\n", result->pauseP99Ms);
+		omrfile_printf(fd, "\t\t\t\"pauseMaxMs\": %f\n", result->pauseMaxMs);
+		omrfile_printf(fd, "\t\t}");
+		separator = ",\n";
+	}
+	omrfile_printf(fd, "\n\t}\n}\n");
+	omrfile_close(fd);
+	return true;
+}
+
+/**
+ * Minimal reader for the JSON written by writeScenarioBaseline(): objects, strings and numbers.
+ * Numbers are stored under their dotted path, e.g. "scenarios.VerboseGC-scenario_gencon.throughput".
+ */
+class BaselineReader
+{
+private:
+	const char *_cursor;
+	std::map<std::string, double> *_values;
+
+	void
+	skipSpace()
+	{
+		while ((' ' == *_cursor) || ('\t' == *_cursor) || ('\n' == *_cursor) || ('\r' == *_cursor)) {
+			_cursor += 1;
+		}
+	}
+
+	bool
+	readString(std::string *value)
+	{
+		if ('"' != *_cursor) {
+			return false;
+		}
+		const char *end = strchr(_cursor + 1, '"');
+		if (NULL == end) {
+			return false;
+		}
+		value->assign(_cursor + 1, end - _cursor - 1);
+		_cursor = end + 1;
+		return true;
+	}
+
+	bool
+	readValue(const std::string &path)
+	{
+		skipSpace();
+		if ('{' == *_cursor) {
+			return readObject(path);
+		}
+		if ('"' == *_cursor) {
+			std::string ignored;
+			return readString(&ignored);
+		}
+		char *end = NULL;
+		double value = strtod(_cursor, &end);
+		if (end == _cursor) {
+			return false;
+		}
+		(*_values)[path] = value;
+		_cursor = end;
+		return true;
+	}
+
+	bool
+	readObject(const std::string &path)
+	{
+		_cursor += 1;
+		skipSpace();
+		if ('}' == *_cursor) {
+			_cursor += 1;
+			return true;
+		}
+		for (;;) {
+			std::string key;
+			skipSpace();
+			if (!readString(&key)) {
+				return false;
+			}
+			skipSpace();
+			if (':' != *_cursor) {
+				return false;
+			}
+			_cursor += 1;
+			if (!readValue(path.empty() ? key : (path + "." + key))) {
+				return false;
+			}
+			skipSpace();
+			if (',' == *_cursor) {
+				_cursor += 1;
+			} else if ('}' == *_cursor) {
+				_cursor += 1;
+				return true;
+			} else {
+				return false;
+			}
+		}
+	}
+
+public:
+	BaselineReader(const char *text, std::map<std::string, double> *values)
+		: _cursor(text)
+		, _values(values)
+	{
+	}
+
+	bool
+	read()
+	{
+		skipSpace();
+		return ('{' == *_cursor) && readObject("");
+	}
+};
+
+bool
+readScenarioBaseline(OMRPortLibrary *portLibrary, const char *fileName, ScenarioResultMap *baseline, double *tolerancePercent)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	intptr_t fd = omrfile_open(fileName, EsOpenRead, 0);
+	if (-1 == fd) {
+		omrtty_printf("Failed to open baseline file %s\n", fileName);
+		return false;
+	}
+	std::string text;
+	char buffer[4096];
+	intptr_t bytesRead = 0;
+	while (0 < (bytesRead = omrfile_read(fd, buffer, sizeof(buffer)))) {
+		text.append(buffer, bytesRead);
+	}
+	omrfile_close(fd);
+
+	std::map<std::string, double> values;
+	BaselineReader reader(text.c_str(), &values);
+	if (!reader.read()) {
+		omrtty_printf("Malformed baseline file %s\n", fileName);
+		return false;
+	}
+
+	const std::string scenarioPrefix("scenarios.");
+	for (std::map<std::string, double>::const_iterator it = values.begin(); it != values.end(); ++it) {
+		const std::string &key = it->first;
+		if ("tolerancePercent" == key) {
+			*tolerancePercent = it->second;
+		} else if (0 == key.compare(0, scenarioPrefix.size(), scenarioPrefix)) {
+			size_t metricStart = key.rfind('.');
+			std::string name = key.substr(scenarioPrefix.size(), metricStart - scenarioPrefix.size());
+			std::string metric = key.substr(metricStart + 1);
+			ScenarioResult *result = &(*baseline)[name];
+			result->name = name;
+			if ("throughput" == metric) {
+				result->throughput = it->second;
+			} else if ("allocationRateMBps" == metric) {
+				result->allocationRateMBps = it->second;
+			} else if ("pauseP50Ms" == metric) {
+				result->pauseP50Ms = it->second;
+			} else if ("pauseP90Ms" == metric) {
+				result->pauseP90Ms = it->second;
+			} else if ("pauseP99Ms" == metric) {
+				result->pauseP99Ms = it->second;
+			} else if ("pauseMaxMs" == metric) {
+				result->pauseMaxMs = it->second;
+			}
+		}
+	}
+	return true;
+}
+
+static bool
+checkLower(OMRPortLibrary *portLibrary, const std::string &name, const char *metric, double value, double baseline, double tolerancePercent)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	if (value < (baseline * (1.0 - (tolerancePercent / 100.0)))) {
+		omrtty_printf("REGRESSION %s: %s %f is below baseline %f\n", name.c_str(), metric, value, baseline);
+		return true;
+	}
+	return false;
+}
+
+static bool
+checkHigher(OMRPortLibrary *portLibrary, const std::string &name, const char *metric, double value, double baseline, double tolerancePercent)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	double allowance = std::max(baseline * (tolerancePercent / 100.0), PAUSE_NOISE_FLOOR_MS);
+	if (value > (baseline + allowance)) {
+		omrtty_printf("REGRESSION %s: %s %f ms is above baseline %f ms\n", name.c_str(), metric, value, baseline);
+		return true;
+	}
+	return false;
+}
+
+size_t
+compareWithScenarioBaseline(OMRPortLibrary *portLibrary, const ScenarioResultMap &results, const ScenarioResultMap &baseline, double tolerancePercent)
+{
+	OMRPORT_ACCESS_FROM_OMRPORT(portLibrary);
+	size_t regressions = 0;
+	for (ScenarioResultMap::const_iterator it = results.begin(); it != results.end(); ++it) {
+		const ScenarioResult *result = &it->second;
+		ScenarioResultMap::const_iterator baselineIt = baseline.find(it->first);
+		if (baseline.end() == baselineIt) {
+			omrtty_printf("No baseline for scenario %s\n", it->first.c_str());
+			continue;
+		}
+		const ScenarioResult *expected = &baselineIt->second;
+		regressions += checkLower(portLibrary, it->first, "throughput", result->throughput, expected->throughput, tolerancePercent) ? 1 : 0;
+		regressions += checkLower(portLibrary, it->first, "allocation rate", result->allocationRateMBps, expected->allocationRateMBps, tolerancePercent) ? 1 : 0;
+		regressions += checkHigher(portLibrary, it->first, "p50 pause", result->pauseP50Ms, expected->pauseP50Ms, tolerancePercent) ? 1 : 0;
+		regressions += checkHigher(portLibrary, it->first, "p90 pause", result->pauseP90Ms, expected->pauseP90Ms, tolerancePercent) ? 1 : 0;
+		regressions += checkHigher(portLibrary, it->first, "p99 pause", result->pauseP99Ms, expected->pauseP99Ms, tolerancePercent) ? 1 : 0;
+		regressions += checkHigher(portLibrary, it->first, "max pause", result->pauseMaxMs, expected->pauseMaxMs, tolerancePercent) ? 1 : 0;
+	}
+	if (0 == regressions) {
+		omrtty_printf("No regressions against baseline (tolerance %f%%)\n", tolerancePercent);
+	}
+	return regressions;
+}
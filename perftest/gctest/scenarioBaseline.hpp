@@ -0,0 +1,82 @@
+/*******************************************************************************
+ * Copyright (c) 2019, 2019 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#if !defined(SCENARIOBASELINE_HPP_)
+#define SCENARIOBASELINE_HPP_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "pugixml.hpp"
+
+#include "omrport.h"
+
+/**
+ * Throughput and pause figures for one GC benchmark scenario, taken from its verbose GC log.
+ * All times are in milliseconds; the run is measured from verbose GC initialization to the end of the last pause.
+ */
+typedef struct ScenarioResult {
+	std::string name; /**< verbose log prefix, e.g. VerboseGC-scenario_gencon */
+	size_t pauseCount;
+	double pauseP50Ms;
+	double pauseP90Ms;
+	double pauseP99Ms;
+	double pauseMaxMs;
+	double totalPauseMs;
+	double elapsedMs;
+	double throughput; /**< fraction of elapsed time not spent in stop-the-world pauses */
+	double allocationRateMBps; /**< bytes allocated between collections per second of elapsed time */
+} ScenarioResult;
+
+typedef std::map<std::string, ScenarioResult> ScenarioResultMap;
+
+/**
+ * Derive the scenario name from a verbose log file name by dropping the _<pid>_<millis>.xml suffix added by GCConfigTest.
+ */
+std::string scenarioNameFromLogFile(const char *fileName);
+
+/**
+ * Summarize the pauses recorded in a verbose GC log.
+ */
+void collectScenarioResult(pugi::xml_document &doc, const std::string &name, ScenarioResult *result);
+
+void printScenarioResult(OMRPortLibrary *portLibrary, const ScenarioResult *result);
+
+/**
+ * Write results as a baseline JSON file.
+ * @return true on success
+ */
+bool writeScenarioBaseline(OMRPortLibrary *portLibrary, const char *fileName, const ScenarioResultMap &results, double tolerancePercent);
+
+/**
+ * Read a baseline JSON file written by writeScenarioBaseline().
+ * @return true on success
+ */
+bool readScenarioBaseline(OMRPortLibrary *portLibrary, const char *fileName, ScenarioResultMap *baseline, double *tolerancePercent);
+
+/**
+ * Report every scenario whose throughput or allocation rate dropped, or whose pauses grew, by more than tolerancePercent of its baseline.
+ * @return number of regressions found
+ */
+size_t compareWithScenarioBaseline(OMRPortLibrary *portLibrary, const ScenarioResultMap &results, const ScenarioResultMap &baseline, double tolerancePercent);
+
+#endif /* SCENARIOBASELINE_HPP_ */
@@ -20,6 +20,7 @@
  * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
  *******************************************************************************/
 
+#include <stdlib.h>
 #include <string.h>
 #include <algorithm>
 #include <vector>
@@ -33,6 +34,8 @@
 #include "omrport.h"
 #include "omrthread.h"
 
+#include "scenarioBaseline.hpp"
+
 const char* XPATH_GET_ALL_MARK_TIME = "/verbosegc/gc-op[@type='mark']";
 const char* XPATH_GET_ALL_SWEEP_TIME = "/verbosegc/gc-op[@type='sweep']";
 const char* XPATH_GET_ALL_EXPAND_TIME = "/verbosegc/heap-resize[@type='expand']";
@@ -41,10 +44,37 @@ const char* SRC_DIR = "./";
 const char* VERBOSE_GC_FILE_PREFIX = "VerboseGC";
 
 double getAvg(std::vector<double> v);
-void analyze(char* fileName, OMRPortLibrary portLibrary);
+void analyze(char* fileName, OMRPortLibrary portLibrary, ScenarioResultMap *results);
 
-int main(void)
+/**
+ * Summarize the verbose GC logs left by omrgctest --gtest_filter="perfTest*" -keepVerboseLog.
+ *
+ * Options:
+ *   -baseline <file>        compare throughput and pause percentiles with a baseline JSON; exit with 1 on regression
+ *   -writeBaseline <file>   store this run's results as a new baseline JSON
+ *   -tolerance <percent>    allowed deviation from the baseline (default: the baseline's own, or 10)
+ */
+int main(int argc, char **argv)
 {
+	const char *baselineFile = NULL;
+	const char *writeBaselineFile = NULL;
+	double tolerancePercent = -1.0;
+	ScenarioResultMap results;
+	int exitCode = 0;
+
+	for (int i = 1; i < argc; i++) {
+		if ((0 == strcmp(argv[i], "-baseline")) && ((i + 1) < argc)) {
+			baselineFile = argv[++i];
+		} else if ((0 == strcmp(argv[i], "-writeBaseline")) && ((i + 1) < argc)) {
+			writeBaselineFile = argv[++i];
+		} else if ((0 == strcmp(argv[i], "-tolerance")) && ((i + 1) < argc)) {
+			tolerancePercent = atof(argv[++i]);
+		} else {
+			fprintf(stderr, "Usage: %s [-baseline <file>] [-writeBaseline <file>] [-tolerance <percent>]\n", argv[0]);
+			return -1;
+		}
+	}
+
 	int32_t totalFiles = 0;
 	intptr_t rc = 0;
 	char resultBuffer[128];
@@ -75,7 +105,7 @@ int main(void)
 
 	while ((uintptr_t)-1 != rcFile) {
 		if (strncmp(resultBuffer, VERBOSE_GC_FILE_PREFIX, strlen(VERBOSE_GC_FILE_PREFIX)) == 0) {
-			analyze(resultBuffer, portLibrary);
+			analyze(resultBuffer, portLibrary, &results);
 			totalFiles++;
 			/* Clean up verbose log file */
 			omrfile_unlink(resultBuffer);
@@ -90,8 +120,34 @@ int main(void)
 		omrtty_printf("Failed to find any verbose GC file to process!\n\n");
 	}
 
+	for (ScenarioResultMap::const_iterator it = results.begin(); it != results.end(); ++it) {
+		printScenarioResult(&portLibrary, &it->second);
+	}
+
+	if (NULL != baselineFile) {
+		ScenarioResultMap baseline;
+		double baselineTolerancePercent = 10.0;
+		if (!readScenarioBaseline(&portLibrary, baselineFile, &baseline, &baselineTolerancePercent)) {
+			exitCode = -1;
+		} else {
+			if (0.0 > tolerancePercent) {
+				tolerancePercent = baselineTolerancePercent;
+			}
+			if (0 != compareWithScenarioBaseline(&portLibrary, results, baseline, tolerancePercent)) {
+				exitCode = 1;
+			}
+		}
+	}
+
+	if (NULL != writeBaselineFile) {
+		if (!writeScenarioBaseline(&portLibrary, writeBaselineFile, results, (0.0 > tolerancePercent) ? 10.0 : tolerancePercent)) {
+			exitCode = -1;
+		}
+	}
+
 	portLibrary.port_shutdown_library(&portLibrary);
 	omrthread_detach(NULL);
+	return exitCode;
 }
 
 double
@@ -103,7 +159,7 @@ getAvg(std::vector<double> v)
 }
 
 void
-analyze(char* fileName, OMRPortLibrary portLibrary)
+analyze(char* fileName, OMRPortLibrary portLibrary, ScenarioResultMap *results)
 {
 	std::vector<double> mark_values;
 	std::vector<double> sweep_values;
@@ -204,4 +260,7 @@ analyze(char* fileName, OMRPortLibrary portLibrary)
 
 	omrtty_printf("Average : %f        %f        %f        %f\n\n",
 								avgMark, avgSweep, avgExpand, avgGCDuration);
+
+	std::string scenarioName = scenarioNameFromLogFile(fileName);
+	collectScenarioResult(doc, scenarioName, &(*results)[scenarioName]);
 }
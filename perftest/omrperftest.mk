@@ -44,6 +44,6 @@ all: test
 	
 omr_perfgctest:
 	./omrgctest --gtest_filter="perfTest*" -keepVerboseLog
-	./omrperfgctest
+	./omrperfgctest -baseline perftest/gctest/configuration/baseline.json
 
 .PHONY: all test omr_perfgctest 